@@ -2,6 +2,10 @@
 
 #include <wren.hpp>
 
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "index.hpp"
@@ -16,28 +20,94 @@ namespace wrenbind17 {
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     namespace detail {
+        // Shared pointers of the finalized foreign objects waiting to be destroyed, one per VM
+        class ReleaseQueue {
+        public:
+            void push(std::shared_ptr<void> ptr) {
+                std::lock_guard<std::mutex> lock(mutex);
+                items.push_back(std::move(ptr));
+            }
+
+            size_t drain(const size_t max) {
+                std::deque<std::shared_ptr<void>> batch;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (max == 0 || max >= items.size()) {
+                        batch.swap(items);
+                    } else {
+                        batch.insert(batch.end(), std::make_move_iterator(items.begin()),
+                                     std::make_move_iterator(items.begin() + max));
+                        items.erase(items.begin(), items.begin() + max);
+                    }
+                }
+                // The destructors run here, outside of the lock
+                const auto count = batch.size();
+                batch.clear();
+                return count;
+            }
+
+            size_t size() {
+                std::lock_guard<std::mutex> lock(mutex);
+                return items.size();
+            }
+
+        private:
+            std::mutex mutex;
+            std::deque<std::shared_ptr<void>> items;
+        };
+
         template <typename T, typename... Args> struct ForeignKlassAllocator {
-            static T* ctor(Args&&... args) {
-                return new T(std::forward<Args>(args)...);
+            static std::shared_ptr<T> ctor(Args&&... args) {
+                return makeForeignShared<T>(std::forward<Args>(args)...);
             }
-            template <size_t... Is> static T* ctorFrom(WrenVM* vm, detail::index_list<Is...>) {
+            template <size_t... Is> static std::shared_ptr<T> ctorFrom(WrenVM* vm, detail::index_list<Is...>) {
                 return ctor(PopHelper<Args>::f(vm, Is + 1)...);
             }
+            template <size_t... Is> static void valueFrom(WrenVM* vm, void* memory, detail::index_list<Is...>) {
+                new (memory) ForeignValue<T>(PopHelper<Args>::f(vm, Is + 1)...);
+            }
             static void allocate(WrenVM* vm) {
-                auto* memory = wrenSetSlotNewForeign(vm, 0, 0, sizeof(ForeignObject<T>));
-                new (memory) ForeignObject<T>();
-                auto* wrapper = reinterpret_cast<ForeignObject<T>*>(memory);
-                try {
-                    wrapper->ptr.reset(ctorFrom(vm, detail::index_range<0, sizeof...(Args)>()));
-                } catch (std::exception& e) {
-                    wrenEnsureSlots(vm, 1);
-                    wrenSetSlotString(vm, 0, e.what());
-                    wrenAbortFiber(vm, 0);
+                if constexpr (ForeignInlinePolicy<T>::value) {
+                    // Both must fit, the empty object is a placeholder if the constructor throws
+                    constexpr auto size = std::max(sizeof(ForeignValue<T>), sizeof(ForeignObject<T>));
+                    auto* memory = wrenSetSlotNewForeign(vm, 0, 0, size);
+                    try {
+                        valueFrom(vm, memory, detail::index_range<0, sizeof...(Args)>());
+                    } catch (std::exception& e) {
+                        new (memory) ForeignObject<T>();
+                        wrenEnsureSlots(vm, 1);
+                        wrenSetSlotString(vm, 0, e.what());
+                        wrenAbortFiber(vm, 0);
+                    }
+                } else {
+                    auto* memory = wrenSetSlotNewForeign(vm, 0, 0, sizeof(ForeignObject<T>));
+                    new (memory) ForeignObject<T>();
+                    auto* wrapper = reinterpret_cast<ForeignObject<T>*>(memory);
+                    wrapper->releases = getReleaseQueue(vm, typeid(T).hash_code());
+                    try {
+                        wrapper->ptr = ctorFrom(vm, detail::index_range<0, sizeof...(Args)>());
+                    } catch (std::exception& e) {
+                        wrenEnsureSlots(vm, 1);
+                        wrenSetSlotString(vm, 0, e.what());
+                        wrenAbortFiber(vm, 0);
+                    }
                 }
             }
             static void finalize(void* memory) {
-                auto* wrapper = reinterpret_cast<ForeignObject<T>*>(memory);
-                wrapper->~ForeignObject<T>();
+                // Owned or borrowed, the virtual destructor takes care of it
+                auto* wrapper = reinterpret_cast<Foreign*>(memory);
+                wrapper->~Foreign();
+            }
+            static void finalizeDeferred(void* memory) {
+                auto* wrapper = reinterpret_cast<Foreign*>(memory);
+                if (!wrapper->borrowed()) {
+                    auto* object = reinterpret_cast<ForeignObject<T>*>(memory);
+                    // Only the last owner needs to be deferred
+                    if (object->releases && object->ptr && object->ptr.use_count() == 1) {
+                        object->releases->push(std::move(object->ptr));
+                    }
+                }
+                wrapper->~Foreign();
             }
         };
     } // namespace detail
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <typeinfo>
+#include <cstring>
 #include <memory>
 
 #include "handle.hpp"
@@ -17,6 +18,9 @@ namespace wrenbind17 {
      * @see Any
      * @details This extends the lifetime of the Wren object (handle). As long as
      * this ReturnValue instance exists the Wren object will exist.
+     * Null, booleans, numbers, and short strings are stored inline and do not
+     * hold any Wren handle. Only the other Wren objects (lists, maps, instances)
+     * hold a handle.
      * @note This variable can safely outlive the wrenbind17::VM class. If that happens
      * then functions of this class will throw wrenbind17::RuntimeError exception. This
      * holder will not try to free the Wren variable if the VM has been terminated. You
@@ -24,8 +28,28 @@ namespace wrenbind17 {
      */
     class ReturnValue {
     public:
+        /*!
+         * @brief Maximum length of a string that is stored inline without a Wren handle
+         */
+        static constexpr size_t inlineStringSize = 23;
+
         ReturnValue() = default;
-        explicit ReturnValue(const WrenType type, Handle handle) : type(type), handle(std::move(handle)) {
+        explicit ReturnValue(const WrenType type, Handle handle, const size_t foreignHash = 0)
+            : type(type), handle(std::move(handle)), foreignHash(foreignHash) {
+        }
+        explicit ReturnValue(const std::shared_ptr<WrenVM>& vm, const bool value)
+            : type(WrenType::WREN_TYPE_BOOL), handle(vm, nullptr) {
+            inlined.boolean = value;
+        }
+        explicit ReturnValue(const std::shared_ptr<WrenVM>& vm, const double value)
+            : type(WrenType::WREN_TYPE_NUM), handle(vm, nullptr) {
+            inlined.number = value;
+        }
+        explicit ReturnValue(const std::shared_ptr<WrenVM>& vm, const char* str, const size_t length)
+            : type(WrenType::WREN_TYPE_STRING), handle(vm, nullptr) {
+            std::memcpy(inlined.str, str, length);
+            inlined.str[length] = '\0';
+            strLength = static_cast<uint8_t>(length);
         }
         ~ReturnValue() = default;
 
@@ -45,10 +69,14 @@ namespace wrenbind17 {
         void swap(ReturnValue& other) noexcept {
             std::swap(type, other.type);
             std::swap(handle, other.handle);
+            std::swap(inlined, other.inlined);
+            std::swap(strLength, other.strLength);
+            std::swap(foreignHash, other.foreignHash);
         }
 
         /*!
          * Returns the handle that this instance owns
+         * @note The handle holds no Wren object if the value is stored inline (see isInline())
          */
         const Handle& getHandle() const {
             return handle;
@@ -56,6 +84,7 @@ namespace wrenbind17 {
 
         /*!
          * Returns the handle that this instance owns
+         * @note The handle holds no Wren object if the value is stored inline (see isInline())
          */
         Handle& getHandle() {
             return handle;
@@ -68,6 +97,13 @@ namespace wrenbind17 {
             return type;
         }
 
+        /*!
+         * @brief Returns true if the value is stored without a Wren handle
+         */
+        bool isInline() const {
+            return handle.getHandle() == nullptr;
+        }
+
         /*!
          * @brief Check if the value held is some specific C++ type
          * @note If the value held is a Wren numeric type then checking for any
@@ -77,10 +113,16 @@ namespace wrenbind17 {
             if (type == WREN_TYPE_NULL) {
                 return false;
             }
+            using Type = typename std::remove_reference<typename std::remove_pointer<T>::type>::type;
+            if (type == WREN_TYPE_FOREIGN) {
+                return foreignHash == typeid(Type).hash_code();
+            }
+            if (isInline()) {
+                return false;
+            }
             if (const auto vm = handle.getVmWeak().lock()) {
                 wrenEnsureSlots(vm.get(), 1);
                 wrenSetSlotHandle(vm.get(), 0, handle.getHandle());
-                using Type = typename std::remove_reference<typename std::remove_pointer<T>::type>::type;
                 return detail::is<Type>(vm.get(), 0);
             } else {
                 throw RuntimeError("Invalid handle");
@@ -99,6 +141,9 @@ namespace wrenbind17 {
          * @brief Returns the value
          * @note If the value held is a Wren numeric type then getting for any
          * C++ integral or floating type will result in a cast from a double to that type.
+         * @note A native Wren map can be returned as std::map or std::unordered_map, the map
+         * is converted by calling MapEntries.of(_) in Wren. This throws BadCast while Wren is
+         * running, for example from within a foreign function, pass MapEntries.of(map) instead.
          * @throws RuntimeError if this instance is invalid (constructed via the default constructor)
          * @throws BadCast if the type required by specifying the template argument does not match the type held
          * @tparam T the type you want to get
@@ -108,9 +153,29 @@ namespace wrenbind17 {
             if (type == WREN_TYPE_NULL) {
                 throw BadCast("Bad cast when getting value from Wren");
             }
+            if (isInline()) {
+                // Matching types are converted without touching the VM
+                if constexpr (std::is_same<T, bool>::value) {
+                    if (type == WREN_TYPE_BOOL)
+                        return inlined.boolean;
+                } else if constexpr (std::is_arithmetic<T>::value) {
+                    if (type == WREN_TYPE_NUM)
+                        return static_cast<T>(inlined.number);
+                } else if constexpr (std::is_same<T, std::string>::value) {
+                    if (type == WREN_TYPE_STRING)
+                        return std::string(inlined.str, strLength);
+                }
+            }
             if (const auto vm = handle.getVmWeak().lock()) {
+                if constexpr (detail::is_native_map<T>::value) {
+                    if (type == WREN_TYPE_MAP) {
+                        // Native maps are converted in Wren first, this throws while Wren is running
+                        callMapEntries(vm.get(), handle.getHandle());
+                        return detail::PopHelper<T>::f(vm.get(), 0);
+                    }
+                }
                 wrenEnsureSlots(vm.get(), 1);
-                wrenSetSlotHandle(vm.get(), 0, handle.getHandle());
+                push(vm.get(), 0);
                 return detail::PopHelper<T>::f(vm.get(), 0);
             } else {
                 throw RuntimeError("Invalid handle");
@@ -129,9 +194,40 @@ namespace wrenbind17 {
             return as<std::shared_ptr<T>>();
         }
 
+        /*!
+         * @brief Puts the value into a slot
+         */
+        void push(WrenVM* vm, const int idx) const {
+            if (!isInline()) {
+                wrenSetSlotHandle(vm, idx, handle.getHandle());
+                return;
+            }
+            switch (type) {
+                case WREN_TYPE_BOOL:
+                    wrenSetSlotBool(vm, idx, inlined.boolean);
+                    break;
+                case WREN_TYPE_NUM:
+                    wrenSetSlotDouble(vm, idx, inlined.number);
+                    break;
+                case WREN_TYPE_STRING:
+                    wrenSetSlotBytes(vm, idx, inlined.str, strLength);
+                    break;
+                default:
+                    wrenSetSlotNull(vm, idx);
+                    break;
+            }
+        }
+
     private:
         WrenType type = WrenType::WREN_TYPE_NULL;
         Handle handle;
+        union {
+            bool boolean;
+            double number;
+            char str[inlineStringSize + 1];
+        } inlined{};
+        uint8_t strLength{0};
+        size_t foreignHash{0};
     };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -216,9 +312,29 @@ namespace wrenbind17 {
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     template <> inline Any detail::getSlot(WrenVM* vm, const int idx) {
-        const auto type = wrenGetSlotType(vm, 0);
-        if (type == WREN_TYPE_NULL) {
-            return Any();
+        const auto type = wrenGetSlotType(vm, idx);
+        switch (type) {
+            case WREN_TYPE_NULL:
+                return Any();
+            case WREN_TYPE_BOOL:
+                return Any(getSharedVm(vm), wrenGetSlotBool(vm, idx));
+            case WREN_TYPE_NUM:
+                return Any(getSharedVm(vm), wrenGetSlotDouble(vm, idx));
+            case WREN_TYPE_STRING: {
+                int length = 0;
+                const auto* str = wrenGetSlotBytes(vm, idx, &length);
+                if (static_cast<size_t>(length) <= Any::inlineStringSize) {
+                    return Any(getSharedVm(vm), str, static_cast<size_t>(length));
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (type == WREN_TYPE_FOREIGN) {
+            // Cached so is<T>() does not need the VM
+            const auto hash = reinterpret_cast<Foreign*>(wrenGetSlotForeign(vm, idx))->hash();
+            return Any(type, Handle(getSharedVm(vm), wrenGetSlotHandle(vm, idx)), hash);
         }
         return Any(type, Handle(getSharedVm(vm), wrenGetSlotHandle(vm, idx)));
     }
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "archiveview.hpp"
+#include "exception.hpp"
+#include "mapped.hpp"
+#include "vm.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief A single file holding many Wren modules, with a sorted index
+     * @details The archive is memory mapped via MappedFile and the modules are looked up
+     * with a binary search over the index, so serving an import does not touch the filesystem.
+     * Each source is stored with a null terminator and is handed to Wren without copying.
+     * Archives are created via Archive::write(), the wrenbind17_pack tool, or the
+     * wrenbind17_add_archive() CMake function. See ArchiveView for the layout.
+     *
+     * @code
+     * wren::VM vm;
+     * wren::Archive archive("scripts.wbar");
+     * archive.install(vm);
+     * vm.runFromModule("main");
+     * @endcode
+     */
+    class Archive : public ArchiveView {
+    public:
+        /*!
+         * @brief Maps the archive file
+         * @throws Exception if the file can not be mapped or is not a valid archive
+         */
+        explicit Archive(const std::string& path) : file(MappedFile::open(path)) {
+            parse(file->data(), file->size());
+        }
+
+        /*!
+         * @brief Uses an archive that is already in memory, for example embedded in the binary
+         * @details The memory is not copied and must outlive this archive.
+         * @throws Exception if the data is not a valid archive
+         */
+        Archive(const uint8_t* data, const size_t size) : ArchiveView(data, size) {
+        }
+
+        /*!
+         * @brief Serves all imports of the VM from this archive
+         * @details Replaces the path resolver and the source loader of the VM. The import
+         * names are used as they are, and modules that are not in the archive fail to load.
+         * The sources are given to Wren straight from the archive memory, nothing is copied.
+         * The archive is copied into the functions, the mapping stays alive with them.
+         */
+        void install(VM& vm) const {
+            const auto self = *this;
+            vm.setPathResolveFunc([](const std::vector<std::string>& paths, const std::string& importer,
+                                     const std::string& name) -> std::string {
+                (void)paths;
+                (void)importer;
+                return name;
+            });
+            vm.setImportCache(false);
+            vm.setLoadSourceFunc([self](const std::string& name) -> const char* {
+                size_t length = 0;
+                return self.find(name, length);
+            });
+        }
+
+    private:
+        std::shared_ptr<MappedFile> file;
+    };
+} // namespace wrenbind17
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        inline uint64_t readLittleEndian(const uint8_t* src, const size_t size) {
+            uint64_t res = 0;
+            for (size_t i = 0; i < size; i++) {
+                res |= static_cast<uint64_t>(src[i]) << (8 * i);
+            }
+            return res;
+        }
+
+        inline void writeLittleEndian(std::ostream& os, const uint64_t value, const size_t size) {
+            for (size_t i = 0; i < size; i++) {
+                os.put(static_cast<char>((value >> (8 * i)) & 0xff));
+            }
+        }
+    } // namespace detail
+#endif
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Reads and writes the archive format of Archive, does not depend on Wren
+     * @details The view does not own the memory, the memory must outlive it. The modules
+     * are looked up with a binary search over the index, and each source is stored with
+     * a null terminator, so find() returns a pointer into the archive memory.
+     *
+     * The layout is little endian: a 16 byte header ("WBAR", version, entry count, reserved),
+     * followed by 24 byte entries (name offset, name size, source offset, source size)
+     * sorted by the module name, followed by the names and the sources.
+     * @see Archive
+     */
+    class ArchiveView {
+    public:
+        static constexpr uint32_t version = 1;
+        static constexpr size_t headerSize = 16;
+        static constexpr size_t entrySize = 24;
+
+        ArchiveView() = default;
+
+        /*!
+         * @brief Uses an archive that is already in memory
+         * @throws Exception if the data is not a valid archive
+         */
+        ArchiveView(const uint8_t* data, const size_t size) {
+            parse(data, size);
+        }
+
+        /*!
+         * @brief Returns the number of modules in this archive
+         */
+        size_t size() const {
+            return count;
+        }
+
+        /*!
+         * @brief Returns the name of the module at the position in the sorted index
+         */
+        std::string getName(const size_t i) const {
+            return std::string(nameAt(i));
+        }
+
+        /*!
+         * @brief Returns true if there is a module with this name
+         */
+        bool contains(const std::string& name) const {
+            return lookup(name) != nullptr;
+        }
+
+        /*!
+         * @brief Returns the null terminated source of a module, or nullptr if not found
+         * @param name The module name, which is the file path relative to the packed directory
+         * without the ".wren" extension, for example "utils/strings"
+         * @param length Receives the length of the source without the null terminator
+         */
+        const char* find(const std::string& name, size_t& length) const {
+            const auto entry = lookup(name);
+            if (!entry)
+                return nullptr;
+            length = static_cast<size_t>(detail::readLittleEndian(entry + 16, 8));
+            return reinterpret_cast<const char*>(data + detail::readLittleEndian(entry + 8, 8));
+        }
+
+        /*!
+         * @brief Writes an archive
+         * @param os The output stream, which must be opened in binary mode
+         * @param modules Pairs of the module name and its source, in any order
+         * @throws Exception if two modules have the same name
+         */
+        static void write(std::ostream& os, std::vector<std::pair<std::string, std::string>> modules) {
+            std::sort(modules.begin(), modules.end(),
+                      [](const auto& a, const auto& b) -> bool { return a.first < b.first; });
+            for (size_t i = 1; i < modules.size(); i++) {
+                if (modules[i].first == modules[i - 1].first)
+                    throw Exception("Archive has a duplicate module: " + modules[i].first);
+            }
+
+            os.write("WBAR", 4);
+            detail::writeLittleEndian(os, version, 4);
+            detail::writeLittleEndian(os, modules.size(), 4);
+            detail::writeLittleEndian(os, 0, 4);
+
+            // All names are placed after the index, followed by all null terminated sources
+            auto nameOffset = static_cast<uint64_t>(headerSize + modules.size() * entrySize);
+            auto sourceOffset = nameOffset;
+            for (const auto& pair : modules) {
+                sourceOffset += pair.first.size();
+            }
+            for (const auto& pair : modules) {
+                detail::writeLittleEndian(os, nameOffset, 4);
+                detail::writeLittleEndian(os, pair.first.size(), 4);
+                detail::writeLittleEndian(os, sourceOffset, 8);
+                detail::writeLittleEndian(os, pair.second.size(), 8);
+                nameOffset += pair.first.size();
+                sourceOffset += pair.second.size() + 1;
+            }
+            for (const auto& pair : modules) {
+                os.write(pair.first.data(), static_cast<std::streamsize>(pair.first.size()));
+            }
+            for (const auto& pair : modules) {
+                os.write(pair.second.data(), static_cast<std::streamsize>(pair.second.size()));
+                os.put('\0');
+            }
+        }
+
+    protected:
+        void parse(const uint8_t* ptr, const size_t length) {
+            if (length < headerSize || std::memcmp(ptr, "WBAR", 4) != 0)
+                throw Exception("Not a Wren archive");
+            if (detail::readLittleEndian(ptr + 4, 4) != version)
+                throw Exception("Unsupported Wren archive version");
+
+            data = ptr;
+            count = static_cast<size_t>(detail::readLittleEndian(ptr + 8, 4));
+            index = ptr + headerSize;
+            if (count > (length - headerSize) / entrySize)
+                throw Exception("Wren archive index is out of range");
+
+            // Validated once, so the lookups do not need any checks
+            for (size_t i = 0; i < count; i++) {
+                const auto entry = index + i * entrySize;
+                const auto nameOffset = detail::readLittleEndian(entry, 4);
+                const auto nameSize = detail::readLittleEndian(entry + 4, 4);
+                const auto sourceOffset = detail::readLittleEndian(entry + 8, 8);
+                const auto sourceSize = detail::readLittleEndian(entry + 16, 8);
+                if (nameOffset > length || nameSize > length - nameOffset || sourceOffset >= length ||
+                    sourceSize >= length - sourceOffset || ptr[sourceOffset + sourceSize] != '\0')
+                    throw Exception("Wren archive entry is out of range");
+                if (i > 0 && !(nameAt(i - 1) < nameAt(i)))
+                    throw Exception("Wren archive index is not sorted");
+            }
+        }
+
+        std::string_view nameAt(const size_t i) const {
+            const auto entry = index + i * entrySize;
+            return std::string_view(reinterpret_cast<const char*>(data + detail::readLittleEndian(entry, 4)),
+                                    static_cast<size_t>(detail::readLittleEndian(entry + 4, 4)));
+        }
+
+        const uint8_t* lookup(const std::string& name) const {
+            size_t low = 0;
+            size_t high = count;
+            while (low < high) {
+                const auto mid = low + (high - low) / 2;
+                const auto res = std::string_view(name).compare(nameAt(mid));
+                if (res == 0)
+                    return index + mid * entrySize;
+                if (res < 0)
+                    high = mid;
+                else
+                    low = mid + 1;
+            }
+            return nullptr;
+        }
+
+        const uint8_t* data{nullptr};
+        const uint8_t* index{nullptr};
+        size_t count{0};
+    };
+} // namespace wrenbind17
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#if defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define WRENBIND17_HAS_SPAN 1
+#endif
+#endif
+#endif
+
+#include "module.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief A contiguous array of numbers shared between C++ and Wren
+     * @details The buffer either owns its memory or borrows memory that belongs
+     * to someone else. A borrowed buffer can hold a guard (any shared pointer)
+     * that keeps the real owner of the memory alive for as long as the buffer exists.
+     * Passing a buffer into Wren by a pointer or a reference never copies the data.
+     * Use BufferBindings to register the buffer as a foreign class.
+     *
+     * A read-only buffer may point to memory that can not be written to, for example
+     * a MappedFile view. Use the const accessors to read it, the mutable ones assert.
+     */
+    template <typename T> class Buffer {
+    public:
+        static_assert(std::is_arithmetic<T>::value, "Buffer can only hold numbers");
+
+        typedef T value_type;
+
+        Buffer() = default;
+
+        /*!
+         * @brief Creates an owned buffer of a specific size filled with zeros
+         */
+        explicit Buffer(const size_t size) : owned(size), ptr(owned.data()), length(size) {
+        }
+
+        /*!
+         * @brief Creates an owned buffer by taking over the vector
+         */
+        explicit Buffer(std::vector<T> data) : owned(std::move(data)), ptr(owned.data()), length(owned.size()) {
+        }
+
+        /*!
+         * @brief Creates a buffer that borrows the memory
+         * @param guard Optional owner of the memory that is kept alive by this buffer
+         */
+        Buffer(T* data, const size_t size, std::shared_ptr<const void> guard = nullptr)
+            : ptr(data), length(size), guard(std::move(guard)) {
+        }
+
+        /*!
+         * @brief Creates a read-only buffer that borrows the memory
+         * @param guard Optional owner of the memory that is kept alive by this buffer
+         */
+        Buffer(const T* data, const size_t size, std::shared_ptr<const void> guard = nullptr)
+            : ptr(const_cast<T*>(data)), length(size), guard(std::move(guard)), readonly(true) {
+        }
+
+        Buffer(const Buffer& other) {
+            *this = other;
+        }
+
+        Buffer(Buffer&& other) noexcept {
+            swap(other);
+        }
+
+        ~Buffer() = default;
+
+        Buffer& operator=(const Buffer& other) {
+            if (this != &other) {
+                if (other.isBorrowed()) {
+                    owned.clear();
+                    ptr = other.ptr;
+                } else {
+                    owned = other.owned;
+                    ptr = owned.data();
+                }
+                length = other.length;
+                guard = other.guard;
+                readonly = other.readonly;
+            }
+            return *this;
+        }
+
+        Buffer& operator=(Buffer&& other) noexcept {
+            if (this != &other) {
+                swap(other);
+            }
+            return *this;
+        }
+
+        void swap(Buffer& other) noexcept {
+            std::swap(owned, other.owned);
+            std::swap(ptr, other.ptr);
+            std::swap(length, other.length);
+            std::swap(guard, other.guard);
+            std::swap(readonly, other.readonly);
+        }
+
+        /*!
+         * @brief Returns true if this buffer does not own its memory
+         */
+        bool isBorrowed() const {
+            return ptr != nullptr && ptr != owned.data();
+        }
+
+        /*!
+         * @brief Returns true if this buffer can not be modified from Wren
+         */
+        bool isReadonly() const {
+            return readonly;
+        }
+
+        T* data() {
+            assert(!readonly && "Mutable access to a read-only buffer");
+            return ptr;
+        }
+
+        const T* data() const {
+            return ptr;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        bool empty() const {
+            return length == 0;
+        }
+
+        T* begin() {
+            assert(!readonly && "Mutable access to a read-only buffer");
+            return ptr;
+        }
+
+        T* end() {
+            assert(!readonly && "Mutable access to a read-only buffer");
+            return ptr + length;
+        }
+
+        const T* begin() const {
+            return ptr;
+        }
+
+        const T* end() const {
+            return ptr + length;
+        }
+
+        T& operator[](const size_t index) {
+            assert(!readonly && "Mutable access to a read-only buffer");
+            return ptr[index];
+        }
+
+        const T& operator[](const size_t index) const {
+            return ptr[index];
+        }
+
+        /*!
+         * @brief Returns an element with bounds checking
+         * @throws std::out_of_range if the index is not within the buffer
+         */
+        T& at(const size_t index) {
+            assert(!readonly && "Mutable access to a read-only buffer");
+            if (index >= length)
+                throw std::out_of_range("Buffer index out of range");
+            return ptr[index];
+        }
+
+        /*!
+         * @brief Returns an element with bounds checking
+         * @throws std::out_of_range if the index is not within the buffer
+         */
+        const T& at(const size_t index) const {
+            if (index >= length)
+                throw std::out_of_range("Buffer index out of range");
+            return ptr[index];
+        }
+
+    private:
+        std::vector<T> owned;
+        T* ptr{nullptr};
+        size_t length{0};
+        std::shared_ptr<const void> guard;
+        bool readonly{false};
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief A numeric kernel that can be applied to a buffer via map()
+     */
+    typedef double (*BufferKernel)(double);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        inline std::unordered_map<std::string, BufferKernel>& getBufferKernels() {
+            static std::unordered_map<std::string, BufferKernel> kernels = {
+                {"abs", [](double v) -> double { return std::abs(v); }},
+                {"neg", [](double v) -> double { return -v; }},
+                {"sqrt", [](double v) -> double { return std::sqrt(v); }},
+                {"square", [](double v) -> double { return v * v; }},
+                {"floor", [](double v) -> double { return std::floor(v); }},
+                {"ceil", [](double v) -> double { return std::ceil(v); }},
+                {"round", [](double v) -> double { return std::round(v); }},
+                {"exp", [](double v) -> double { return std::exp(v); }},
+                {"log", [](double v) -> double { return std::log(v); }},
+                {"sin", [](double v) -> double { return std::sin(v); }},
+                {"cos", [](double v) -> double { return std::cos(v); }},
+            };
+            return kernels;
+        }
+    } // namespace detail
+#endif
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Registers a custom numeric kernel usable by Buffer map() from Wren
+     * @note This is shared by all VMs. Register your kernels before any VM uses them.
+     */
+    inline void addBufferKernel(const std::string& name, BufferKernel kernel) {
+        detail::getBufferKernels()[name] = kernel;
+    }
+
+    template <typename T> class BufferBindings {
+    public:
+        typedef Buffer<T> Type;
+
+        static void checkWritable(const Type& self) {
+            if (self.isReadonly())
+                throw Exception("Buffer is read-only");
+        }
+
+        static T getIndex(Type& self, size_t index) {
+            return std::as_const(self).at(index);
+        }
+
+        static void setIndex(Type& self, size_t index, T value) {
+            checkWritable(self);
+            self.at(index) = value;
+        }
+
+        static size_t count(Type& self) {
+            return self.size();
+        }
+
+        static void fill(Type& self, T value) {
+            checkWritable(self);
+            std::fill(self.begin(), self.end(), value);
+        }
+
+        static void copy(Type& self, const Type& other) {
+            checkWritable(self);
+            const auto n = std::min(self.size(), other.size());
+            if (n) {
+                std::memmove(self.data(), other.data(), n * sizeof(T));
+            }
+        }
+
+        static void map(Type& self, const std::string& kernel) {
+            checkWritable(self);
+            const auto& kernels = detail::getBufferKernels();
+            const auto it = kernels.find(kernel);
+            if (it == kernels.end())
+                throw Exception("Buffer kernel '" + kernel + "' not found");
+            const auto fn = it->second;
+            for (auto& v : self) {
+                v = static_cast<T>(fn(static_cast<double>(v)));
+            }
+        }
+
+        static double dot(Type& self, const Type& other) {
+            if (self.size() != other.size())
+                throw Exception("Buffer sizes do not match");
+            double res = 0.0;
+            const auto* a = std::as_const(self).data();
+            const auto* b = other.data();
+            for (size_t i = 0; i < self.size(); i++) {
+                res += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+            }
+            return res;
+        }
+
+        static double sum(Type& self) {
+            double res = 0.0;
+            for (const auto& v : std::as_const(self)) {
+                res += static_cast<double>(v);
+            }
+            return res;
+        }
+
+        static std::vector<T> toList(Type& self) {
+            return std::vector<T>(std::as_const(self).begin(), std::as_const(self).end());
+        }
+
+        static std::variant<bool, size_t> iterate(Type& self, std::variant<std::nullptr_t, size_t> other) {
+            const size_t next = other.index() == 1 ? std::get<size_t>(other) + 1 : 0;
+            if (next < self.size()) {
+                return {next};
+            }
+            return {false};
+        }
+
+        static T iteratorValue(Type& self, size_t index) {
+            return std::as_const(self).at(index);
+        }
+
+        static void bind(ForeignModule& m, const std::string& name) {
+            auto& cls = m.klass<Type>(name);
+            cls.template ctor<size_t>();
+
+            cls.template funcExt<&BufferBindings<T>::getIndex>(OPERATOR_GET_INDEX);
+            cls.template funcExt<&BufferBindings<T>::setIndex>(OPERATOR_SET_INDEX);
+            cls.template funcExt<&BufferBindings<T>::fill>("fill");
+            cls.template funcExt<&BufferBindings<T>::copy>("copy");
+            cls.template funcExt<&BufferBindings<T>::map>("map");
+            cls.template funcExt<&BufferBindings<T>::dot>("dot");
+            cls.template funcExt<&BufferBindings<T>::sum>("sum");
+            cls.template funcExt<&BufferBindings<T>::toList>("toList");
+            cls.template funcExt<&BufferBindings<T>::iterate>("iterate");
+            cls.template funcExt<&BufferBindings<T>::iteratorValue>("iteratorValue");
+            cls.template propReadonlyExt<&BufferBindings<T>::count>("count");
+        }
+    };
+
+    typedef Buffer<uint8_t> ByteArray;
+    typedef Buffer<int32_t> Int32Array;
+    typedef Buffer<float> Float32Array;
+    typedef Buffer<double> Float64Array;
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Registers ByteArray, Int32Array, Float32Array, and Float64Array into a module
+     */
+    inline void bindBuffers(ForeignModule& m) {
+        BufferBindings<uint8_t>::bind(m, "ByteArray");
+        BufferBindings<int32_t>::bind(m, "Int32Array");
+        BufferBindings<float>::bind(m, "Float32Array");
+        BufferBindings<double>::bind(m, "Float64Array");
+    }
+
+#if defined(WRENBIND17_HAS_SPAN) && !defined(DOXYGEN_SHOULD_SKIP_THIS)
+    namespace detail {
+        // Spans are pushed as borrowed buffers, the memory must outlive the Wren object
+        template <typename T> struct PushHelper<std::span<T>> {
+            static inline void f(WrenVM* vm, int idx, std::span<T> value) {
+                using Type = typename std::remove_const<T>::type;
+                pushAsMove<Buffer<Type>>(vm, idx, Buffer<Type>(value.data(), value.size()));
+            }
+        };
+
+        template <typename T> struct PushHelper<const std::span<T>&> {
+            static inline void f(WrenVM* vm, int idx, const std::span<T>& value) {
+                PushHelper<std::span<T>>::f(vm, idx, value);
+            }
+        };
+
+        template <typename T> struct PopHelper<std::span<T>> {
+            static inline std::span<T> f(WrenVM* vm, const int idx) {
+                using Type = typename std::remove_const<T>::type;
+                // Foreign vectors are viewed directly without a copy
+                if (is<std::vector<Type>>(vm, idx)) {
+                    auto* vec = PopHelper<std::vector<Type>*>::f(vm, idx);
+                    return std::span<T>(vec->data(), vec->size());
+                }
+                auto* buffer = PopHelper<Buffer<Type>*>::f(vm, idx);
+                if (!buffer)
+                    return {};
+                if constexpr (std::is_const<T>::value) {
+                    return std::span<T>(std::as_const(*buffer).data(), buffer->size());
+                } else {
+                    if (buffer->isReadonly())
+                        throw BadCast("Bad cast the buffer is read-only");
+                    return std::span<T>(buffer->data(), buffer->size());
+                }
+            }
+        };
+
+        template <typename T> struct PopHelper<const std::span<T>&> {
+            static inline std::span<T> f(WrenVM* vm, const int idx) {
+                return PopHelper<std::span<T>>::f(vm, idx);
+            }
+        };
+    } // namespace detail
+#endif
+} // namespace wrenbind17
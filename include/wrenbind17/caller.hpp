@@ -2,7 +2,11 @@
 
 #include <wren.hpp>
 
+#include <cassert>
 #include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include "index.hpp"
 #include "pop.hpp"
@@ -12,6 +16,44 @@
  * @ingroup wrenbind17
  */
 namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief Whether a bound function checks the types of its arguments
+     * @see checked
+     * @see unchecked
+     */
+    enum class ArgumentCheck { CHECKED, UNCHECKED };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Arguments are checked and a type mismatch aborts the fiber (the default)
+     */
+    constexpr ArgumentCheck checked = ArgumentCheck::CHECKED;
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Arguments are not checked, for scripts that are known to pass the right types
+     * @details Only bool, number, and std::string arguments are affected. Their slot types are
+     * not checked in release builds, and are only asserted when NDEBUG is not defined.
+     * Passing a wrong type from Wren is then undefined behavior. Class instances
+     * are popped the same way as for the checked functions.
+     * @code
+     * cls.func<&Body::applyForce, wren::unchecked>("applyForce");
+     * @endcode
+     */
+    constexpr ArgumentCheck unchecked = ArgumentCheck::UNCHECKED;
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Selects wrenbind17::unchecked as the default for all functions of a class
+     * @details Specialize this as std::true_type for your class. Individual functions
+     * can still be bound with wrenbind17::checked.
+     * @code
+     * template <> struct wrenbind17::ForeignUncheckedPolicy<Body> : std::true_type {};
+     * @endcode
+     */
+    template <typename T> struct ForeignUncheckedPolicy : std::false_type {};
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     namespace detail {
         template <typename R> struct ForeginMethodReturnHelper {
@@ -83,138 +125,378 @@ namespace wrenbind17 {
             PushHelper<std::string&>::f(vm, index, ret);
         }
 
+        // The Wren type an argument must have, if it can be told without popping the value
+        template <typename T> constexpr WrenType slotTypeHint() {
+            using Type = typename std::remove_const<typename std::remove_reference<T>::type>::type;
+            if constexpr (std::is_same<Type, bool>::value)
+                return WrenType::WREN_TYPE_BOOL;
+            else if constexpr (std::is_arithmetic<Type>::value)
+                return WrenType::WREN_TYPE_NUM;
+            else if constexpr (std::is_same<Type, std::string>::value)
+                return WrenType::WREN_TYPE_STRING;
+            else
+                return WrenType::WREN_TYPE_UNKNOWN;
+        }
+
+        // True if popping the arguments can not throw once validateArgs() passes
+        template <typename... Args> constexpr bool argsPrevalidated() {
+            return ((slotTypeHint<Args>() != WrenType::WREN_TYPE_UNKNOWN) && ...);
+        }
+
+        // True if pushing the return value can not throw
+        template <typename R> constexpr bool returnNothrow() {
+            using Type = typename std::remove_const<typename std::remove_reference<R>::type>::type;
+            return std::is_void<Type>::value || std::is_arithmetic<Type>::value;
+        }
+
+        // Formatted once, so that a type mismatch costs nothing more than setting the error
+        inline const char* badCastMessage(const WrenType got, const WrenType expected) {
+            static constexpr int size = WrenType::WREN_TYPE_UNKNOWN + 1;
+            static const auto table = []() {
+                std::vector<std::string> res(size * size);
+                for (int g = 0; g < size; g++) {
+                    for (int e = 0; e < size; e++) {
+                        res[g * size + e] = std::string("Bad cast when getting value from Wren got ") +
+                                            wrenSlotTypeToStr(static_cast<WrenType>(g)) + " expected " +
+                                            wrenSlotTypeToStr(static_cast<WrenType>(e));
+                    }
+                }
+                return res;
+            }();
+            if (got < 0 || got >= size || expected < 0 || expected >= size)
+                return "Bad cast when getting value from Wren";
+            return table[got * size + expected].c_str();
+        }
+
+        template <typename T> inline bool validateArg(WrenVM* vm, const int idx) {
+            constexpr auto expected = slotTypeHint<T>();
+            if constexpr (expected == WrenType::WREN_TYPE_UNKNOWN) {
+                return true;
+            } else {
+                const auto got = wrenGetSlotType(vm, idx);
+                if (got == expected)
+                    return true;
+                wrenSetSlotString(vm, 0, badCastMessage(got, expected));
+                wrenAbortFiber(vm, 0);
+                return false;
+            }
+        }
+
+        // Checks the arguments without throwing, aborts the fiber on the first mismatch
+        template <typename... Args, size_t... Is> inline bool validateArgs(WrenVM* vm, detail::index_list<Is...>) {
+            (void)vm;
+            return (validateArg<Args>(vm, static_cast<int>(Is + 1)) && ...);
+        }
+
+        // Reads a value whose slot type is known to match, see slotTypeHint()
+        template <typename T> inline T getSlotUnchecked(WrenVM* vm, const int idx) {
+            if constexpr (std::is_same<T, bool>::value)
+                return wrenGetSlotBool(vm, idx);
+            else if constexpr (std::is_same<T, std::string>::value)
+                return std::string(wrenGetSlotString(vm, idx));
+            else
+                return static_cast<T>(wrenGetSlotDouble(vm, idx));
+        }
+
+        // Pops an argument of a checked binding
+        template <typename T, bool Unchecked> struct ArgPopHelper {
+            static inline decltype(auto) f(WrenVM* vm, const int idx) {
+                return PopHelper<T>::f(vm, idx);
+            }
+        };
+
+        // Pops an argument of an unchecked binding, the slot type is only asserted in debug builds
+        template <typename T> struct ArgPopHelper<T, true> {
+            static inline decltype(auto) f(WrenVM* vm, const int idx) {
+                constexpr auto expected = slotTypeHint<T>();
+                if constexpr (expected == WrenType::WREN_TYPE_UNKNOWN) {
+                    return PopHelper<T>::f(vm, idx);
+                } else {
+                    assert(wrenGetSlotType(vm, idx) == expected && "Unchecked argument has a wrong type");
+                    return getSlotUnchecked<typename std::remove_const<typename std::remove_reference<T>::type>::type>(
+                        vm, idx);
+                }
+            }
+        };
+
+        template <typename T> constexpr ArgumentCheck defaultArgumentCheck() {
+            return ForeignUncheckedPolicy<T>::value ? ArgumentCheck::UNCHECKED : ArgumentCheck::CHECKED;
+        }
+
+        // Pushing the result and popping the arguments must not throw for the noexcept trampolines
+        template <bool NoExcept, typename R, typename... Args> constexpr bool useNoexceptCall() {
+            return NoExcept && argsPrevalidated<Args...>() && returnNothrow<R>();
+        }
+
+        // Returns the instance if it is exactly T and usable, nullptr otherwise without throwing
+        template <typename T> inline T* peekSelf(WrenVM* vm) {
+            if (wrenGetSlotType(vm, 0) != WrenType::WREN_TYPE_FOREIGN)
+                return nullptr;
+            auto* foreign = reinterpret_cast<Foreign*>(wrenGetSlotForeign(vm, 0));
+            if (foreign->hash() != typeid(T).hash_code() || !foreign->valid())
+                return nullptr;
+            return reinterpret_cast<T*>(foreign->get());
+        }
+
         template <typename R, typename T, typename... Args> struct ForeignMethodCaller {
-            template <R (T::*Fn)(Args...), size_t... Is> static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
+            template <R (T::*Fn)(Args...), bool Unchecked, size_t... Is>
+            static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
                 auto self = PopHelper<T*>::f(vm, 0);
                 // R ret = (self->*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
                 // PushHelper<R>::f(vm, 0, ret);
                 ForeginMethodReturnHelper<R>::push(
-                    vm, 0, (self->*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...));
+                    vm, 0,
+                    (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...));
             }
 
-            template <R (T::*Fn)(Args...)> static void call(WrenVM* vm) {
+            template <R (T::*Fn)(Args...), bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
 
-            template <R (T::*Fn)(Args...) const, size_t... Is>
+            template <R (T::*Fn)(Args...), bool Unchecked, size_t... Is>
+            static void callNoexceptFrom(WrenVM* vm, T* self, detail::index_list<Is...>) {
+                ForeginMethodReturnHelper<R>::push(
+                    vm, 0,
+                    (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...));
+            }
+
+            template <R (T::*Fn)(Args...), bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                auto* self = peekSelf<T>(vm);
+                if (!self)
+                    return call<Fn, Unchecked>(vm);
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callNoexceptFrom<Fn, Unchecked>(vm, self, detail::index_range<0, sizeof...(Args)>());
+            }
+
+            template <R (T::*Fn)(Args...) const, bool Unchecked, size_t... Is>
             static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
                 auto self = PopHelper<T*>::f(vm, 0);
                 // R ret = (self->*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
                 // PushHelper<R>::f(vm, 0, ret);
                 ForeginMethodReturnHelper<R>::push(
-                    vm, 0, (self->*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...));
+                    vm, 0,
+                    (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...));
             }
 
-            template <R (T::*Fn)(Args...) const> static void call(WrenVM* vm) {
+            template <R (T::*Fn)(Args...) const, bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
+
+            template <R (T::*Fn)(Args...) const, bool Unchecked, size_t... Is>
+            static void callNoexceptFrom(WrenVM* vm, T* self, detail::index_list<Is...>) {
+                ForeginMethodReturnHelper<R>::push(
+                    vm, 0,
+                    (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...));
+            }
+
+            template <R (T::*Fn)(Args...) const, bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                auto* self = peekSelf<T>(vm);
+                if (!self)
+                    return call<Fn, Unchecked>(vm);
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callNoexceptFrom<Fn, Unchecked>(vm, self, detail::index_range<0, sizeof...(Args)>());
+            }
         };
 
         template <typename T, typename... Args> struct ForeignMethodCaller<void, T, Args...> {
-            template <void (T::*Fn)(Args...), size_t... Is>
+            template <void (T::*Fn)(Args...), bool Unchecked, size_t... Is>
             static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
                 auto self = PopHelper<T*>::f(vm, 0);
-                (self->*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
+                (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...);
             }
 
-            template <void (T::*Fn)(Args...)> static void call(WrenVM* vm) {
+            template <void (T::*Fn)(Args...), bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
 
-            template <void (T::*Fn)(Args...) const, size_t... Is>
+            template <void (T::*Fn)(Args...), bool Unchecked, size_t... Is>
+            static void callNoexceptFrom(WrenVM* vm, T* self, detail::index_list<Is...>) {
+                (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...);
+            }
+
+            template <void (T::*Fn)(Args...), bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                auto* self = peekSelf<T>(vm);
+                if (!self)
+                    return call<Fn, Unchecked>(vm);
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callNoexceptFrom<Fn, Unchecked>(vm, self, detail::index_range<0, sizeof...(Args)>());
+            }
+
+            template <void (T::*Fn)(Args...) const, bool Unchecked, size_t... Is>
             static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
                 auto self = PopHelper<T*>::f(vm, 0);
-                (self->*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
+                (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...);
             }
 
-            template <void (T::*Fn)(Args...) const> static void call(WrenVM* vm) {
+            template <void (T::*Fn)(Args...) const, bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
+
+            template <void (T::*Fn)(Args...) const, bool Unchecked, size_t... Is>
+            static void callNoexceptFrom(WrenVM* vm, T* self, detail::index_list<Is...>) {
+                (self->*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...);
+            }
+
+            template <void (T::*Fn)(Args...) const, bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                auto* self = peekSelf<T>(vm);
+                if (!self)
+                    return call<Fn, Unchecked>(vm);
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callNoexceptFrom<Fn, Unchecked>(vm, self, detail::index_range<0, sizeof...(Args)>());
+            }
         };
 
         template <typename R, typename T, typename... Args> struct ForeignMethodExtCaller {
-            template <R (*Fn)(T&, Args...), size_t... Is> static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
+            template <R (*Fn)(T&, Args...), bool Unchecked, size_t... Is>
+            static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
                 auto self = PopHelper<T*>::f(vm, 0);
                 // R ret = (*Fn)(*self, PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
                 // PushHelper<R>::f(vm, 0, ret);
                 ForeginMethodReturnHelper<R>::push(
-                    vm, 0, (*Fn)(*self, PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...));
+                    vm, 0,
+                    (*Fn)(*self, ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...));
             }
 
-            template <R (*Fn)(T&, Args...)> static void call(WrenVM* vm) {
+            template <R (*Fn)(T&, Args...), bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
+
+            template <R (*Fn)(T&, Args...), bool Unchecked, size_t... Is>
+            static void callNoexceptFrom(WrenVM* vm, T* self, detail::index_list<Is...>) {
+                ForeginMethodReturnHelper<R>::push(
+                    vm, 0,
+                    (*Fn)(*self, ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...));
+            }
+
+            template <R (*Fn)(T&, Args...), bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                auto* self = peekSelf<T>(vm);
+                if (!self)
+                    return call<Fn, Unchecked>(vm);
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callNoexceptFrom<Fn, Unchecked>(vm, self, detail::index_range<0, sizeof...(Args)>());
+            }
         };
 
         template <typename T, typename... Args> struct ForeignMethodExtCaller<void, T, Args...> {
-            template <void (*Fn)(T&, Args...), size_t... Is>
+            template <void (*Fn)(T&, Args...), bool Unchecked, size_t... Is>
             static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
                 auto self = PopHelper<T*>::f(vm, 0);
-                (*Fn)(*self, PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
+                (*Fn)(*self, ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...);
             }
 
-            template <void (*Fn)(T&, Args...)> static void call(WrenVM* vm) {
+            template <void (*Fn)(T&, Args...), bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
+
+            template <void (*Fn)(T&, Args...), bool Unchecked, size_t... Is>
+            static void callNoexceptFrom(WrenVM* vm, T* self, detail::index_list<Is...>) {
+                (*Fn)(*self, ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...);
+            }
+
+            template <void (*Fn)(T&, Args...), bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                auto* self = peekSelf<T>(vm);
+                if (!self)
+                    return call<Fn, Unchecked>(vm);
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callNoexceptFrom<Fn, Unchecked>(vm, self, detail::index_range<0, sizeof...(Args)>());
+            }
         };
 
         template <typename R, typename... Args> struct ForeignFunctionCaller {
-            template <R (*Fn)(Args...), size_t... Is> static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
+            template <R (*Fn)(Args...), bool Unchecked, size_t... Is>
+            static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
                 // R ret = (*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
                 // PushHelper<R>::f(vm, 0, ret);
                 ForeginMethodReturnHelper<R>::push(
-                    vm, 0, (*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...));
+                    vm, 0, (*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...));
             }
 
-            template <R (*Fn)(Args...)> static void call(WrenVM* vm) {
+            template <R (*Fn)(Args...), bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
+
+            template <R (*Fn)(Args...), bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
+            }
         };
 
         template <typename... Args> struct ForeignFunctionCaller<void, Args...> {
-            template <void (*Fn)(Args...), size_t... Is> static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
-                (*Fn)(PopHelper<typename std::remove_const<Args>::type>::f(vm, Is + 1)...);
+            template <void (*Fn)(Args...), bool Unchecked, size_t... Is>
+            static void callFrom(WrenVM* vm, detail::index_list<Is...>) {
+                (*Fn)(ArgPopHelper<typename std::remove_const<Args>::type, Unchecked>::f(vm, Is + 1)...);
             }
 
-            template <void (*Fn)(Args...)> static void call(WrenVM* vm) {
+            template <void (*Fn)(Args...), bool Unchecked = false> static void call(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
                 try {
-                    callFrom<Fn>(vm, detail::index_range<0, sizeof...(Args)>());
+                    callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
                 } catch (...) {
                     exceptionHandler(vm, std::current_exception());
                 }
             }
+
+            template <void (*Fn)(Args...), bool Unchecked = false> static void callNoexcept(WrenVM* vm) {
+                if (!Unchecked && !validateArgs<Args...>(vm, detail::index_range<0, sizeof...(Args)>()))
+                    return;
+                callFrom<Fn, Unchecked>(vm, detail::index_range<0, sizeof...(Args)>());
+            }
         };
 
         template <typename T, typename V, V T::*Ptr> struct ForeignPropCaller {
             static void setter(WrenVM* vm) {
+                if (!validateArg<V>(vm, 1))
+                    return;
                 auto self = PopHelper<T*>::f(vm, 0);
                 self->*Ptr = PopHelper<V>::f(vm, 1);
             }
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+#include "pop.hpp"
+#include "push.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief Identifies an object owned by a pool on the C++ side
+     * @details The meaning of the fields is up to the resolver. Usually the pool
+     * points to the owning container, the index is the position within the pool,
+     * and the generation is increased each time the position is reused.
+     */
+    struct EntityHandle {
+        void* pool{nullptr};
+        uint32_t index{0};
+        uint32_t generation{0};
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief A generation checked reference to an object owned by a pool
+     * @details Pass this into Wren instead of a pointer when the object can be destroyed
+     * while Wren still holds it. The Wren object stores only the handle and the resolver.
+     * Each time the object is popped as a pointer or a reference, the resolver is called to get
+     * the actual pointer. The resolver must return nullptr for stale handles, popping a stale
+     * handle throws an Exception, which becomes a Wren runtime error inside of foreign functions.
+     * The class T must be registered via klass<T>().
+     */
+    template <typename T> class EntityRef {
+    public:
+        typedef T* (*Resolver)(const EntityHandle&);
+
+        EntityRef() = default;
+
+        EntityRef(const EntityHandle& handle, Resolver resolver) : handle(handle), resolver(resolver) {
+        }
+
+        const EntityHandle& getHandle() const {
+            return handle;
+        }
+
+        Resolver getResolver() const {
+            return resolver;
+        }
+
+        /*!
+         * @brief Returns the object or nullptr if the handle is stale
+         */
+        T* get() const {
+            return resolver ? resolver(handle) : nullptr;
+        }
+
+        operator bool() const {
+            return get() != nullptr;
+        }
+
+    private:
+        EntityHandle handle;
+        Resolver resolver{nullptr};
+    };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        template <typename T> class ForeignEntity : public Foreign {
+        public:
+            explicit ForeignEntity(const EntityRef<T>& entity) : entity(entity) {
+            }
+
+            virtual ~ForeignEntity() = default;
+
+            void* get() const override {
+                auto* ptr = entity.get();
+                if (!ptr)
+                    throw Exception("Entity handle is stale");
+                return ptr;
+            }
+
+            size_t hash() const override {
+                return typeid(T).hash_code();
+            }
+
+            bool borrowed() const override {
+                return true;
+            }
+
+            bool valid() const override {
+                return entity.get() != nullptr;
+            }
+
+            EntityRef<T> entity;
+        };
+
+        template <typename T> struct PushHelper<EntityRef<T>> {
+            static inline void f(WrenVM* vm, int idx, const EntityRef<T>& value) {
+                try {
+                    std::string module;
+                    std::string klass;
+                    getClassType(vm, module, klass, typeid(T).hash_code());
+
+                    wrenEnsureSlots(vm, idx + 1);
+                    wrenGetVariable(vm, module.c_str(), klass.c_str(), idx);
+
+                    auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignEntity<T>));
+                    auto* foreign = new (memory) ForeignEntity<T>(value);
+                    (void)foreign;
+                } catch (std::out_of_range& e) {
+                    (void)e;
+                    throw BadCast("Class type not registered in Wren VM");
+                }
+            }
+        };
+
+        template <typename T> struct PushHelper<const EntityRef<T>&> {
+            static inline void f(WrenVM* vm, int idx, const EntityRef<T>& value) {
+                PushHelper<EntityRef<T>>::f(vm, idx, value);
+            }
+        };
+
+        template <typename T> struct PushHelper<EntityRef<T>&> {
+            static inline void f(WrenVM* vm, int idx, const EntityRef<T>& value) {
+                PushHelper<EntityRef<T>>::f(vm, idx, value);
+            }
+        };
+
+        template <typename T> struct PopHelper<EntityRef<T>> {
+            static inline EntityRef<T> f(WrenVM* vm, const int idx) {
+                validate<WrenType::WREN_TYPE_FOREIGN>(vm, idx);
+                auto* foreign = reinterpret_cast<Foreign*>(wrenGetSlotForeign(vm, idx));
+                auto* ptr = dynamic_cast<ForeignEntity<T>*>(foreign);
+                if (!ptr)
+                    throw BadCast("Bad cast the value is not an entity handle");
+                return ptr->entity;
+            }
+        };
+
+        template <typename T> struct PopHelper<const EntityRef<T>&> {
+            static inline EntityRef<T> f(WrenVM* vm, const int idx) {
+                return PopHelper<EntityRef<T>>::f(vm, idx);
+            }
+        };
+
+        template <typename T> struct CheckSlot<EntityRef<T>> {
+            static bool f(WrenVM* vm, const int idx) {
+                if (!is<T>(vm, idx))
+                    return false;
+                auto* foreign = reinterpret_cast<Foreign*>(wrenGetSlotForeign(vm, idx));
+                return dynamic_cast<ForeignEntity<T>*>(foreign) != nullptr;
+            }
+        };
+
+        template <typename T> struct CheckSlot<const EntityRef<T>&> {
+            static bool f(WrenVM* vm, const int idx) {
+                return CheckSlot<EntityRef<T>>::f(vm, idx);
+            }
+        };
+    } // namespace detail
+#endif
+} // namespace wrenbind17
@@ -2,13 +2,15 @@
 
 #include <wren.hpp>
 
+#include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <ostream>
 #include <unordered_map>
+#include <vector>
 
 #include "allocator.hpp"
 #include "caller.hpp"
+#include "signature.hpp"
 
 /**
  * @ingroup wrenbind17
@@ -184,40 +186,35 @@ namespace wrenbind17 {
 
         /*!
          * @brief Finds a function based on the signature
+         * @throws NotFound if there is no such function or property
          */
         WrenForeignMethodFn findSignature(const std::string& signature, const bool isStatic) {
-            switch (signature[0]) {
-                case '[':
-                case '-':
-                case '+':
-                case '/':
-                case '*':
-                case '=':
-                case '!':
-                case '%':
-                case '<':
-                case '>':
-                case '&':
-                case '^':
-                case '|': {
-                    // Operators
-                    return findFunc(signature, isStatic).getMethod();
-                }
-                default: {
-                    if (signature.find('(') != std::string::npos) {
-                        // Check if setter
-                        if (signature.find("=(_)") != std::string::npos) {
-                            return findProp(signature.substr(0, signature.find_first_of('=')), isStatic).getSetter();
-                        } else {
-                            // Must be a method
-                            return findFunc(signature, isStatic).getMethod();
-                        }
-
-                    } else {
-                        return findProp(signature, isStatic).getGetter();
-                    }
-                }
-            }
+            const auto fn = lookupSignature(signature.c_str(), isStatic);
+            if (!fn)
+                throw NotFound();
+            return fn;
+        }
+
+        /*!
+         * @brief Finds a function based on the exact signature passed by Wren
+         * @details The signatures of all functions and properties are collected into
+         * a sorted table on the first lookup, so binding a method costs one binary
+         * search. The table is rebuilt if more functions are added afterwards.
+         * @return nullptr if there is no such function or property
+         */
+        WrenForeignMethodFn lookupSignature(const char* signature, const bool isStatic) {
+            if (frozenMethods != methods.size() || frozenProps != props.size())
+                freeze();
+
+            const auto it = std::lower_bound(signatures.begin(), signatures.end(), signature,
+                                             [&](const SignatureEntry& entry, const char* sig) {
+                                                 if (entry.isStatic != isStatic)
+                                                     return entry.isStatic < isStatic;
+                                                 return entry.signature.compare(sig) < 0;
+                                             });
+            if (it == signatures.end() || it->isStatic != isStatic || it->signature.compare(signature) != 0)
+                return nullptr;
+            return it->fn;
         }
 
         /*!
@@ -240,6 +237,42 @@ namespace wrenbind17 {
         std::unordered_map<std::string, std::unique_ptr<ForeignMethod>> methods;
         std::unordered_map<std::string, std::unique_ptr<ForeignProp>> props;
         WrenForeignClassMethods allocators;
+
+    private:
+        struct SignatureEntry {
+            bool isStatic;
+            std::string signature;
+            WrenForeignMethodFn fn;
+
+            bool operator<(const SignatureEntry& other) const {
+                if (isStatic != other.isStatic)
+                    return isStatic < other.isStatic;
+                return signature < other.signature;
+            }
+        };
+
+        void freeze() {
+            signatures.clear();
+            signatures.reserve(methods.size() + props.size() * 2);
+            for (const auto& pair : methods) {
+                const auto& method = *pair.second;
+                signatures.push_back({method.getStatic(), method.getName(), method.getMethod()});
+            }
+            for (const auto& pair : props) {
+                auto& prop = *pair.second;
+                if (prop.getGetter())
+                    signatures.push_back({prop.getStatic(), prop.getName(), prop.getGetter()});
+                if (prop.getSetter())
+                    signatures.push_back({prop.getStatic(), prop.getName() + "=(_)", prop.getSetter()});
+            }
+            std::sort(signatures.begin(), signatures.end());
+            frozenMethods = methods.size();
+            frozenProps = props.size();
+        }
+
+        std::vector<SignatureEntry> signatures;
+        size_t frozenMethods{0};
+        size_t frozenProps{0};
     };
 
     /**
@@ -258,20 +291,10 @@ namespace wrenbind17 {
         }
 
         static std::string generateSignature(const std::string& name) {
-            std::stringstream os;
-            constexpr auto n = sizeof...(Args);
-            os << name << "(";
-            for (size_t i = 0; i < n; i++) {
-                if (i == 0)
-                    os << "arg0";
-                else
-                    os << ", arg" << i;
-            }
-            os << ")";
-            return os.str();
+            return name + detail::SignatureText<sizeof...(Args)>::params.data();
         }
 
-        static std::string generateSignature(const ForeignMethodOperator name) {
+        static constexpr const char* generateSignature(const ForeignMethodOperator name) {
             switch (name) {
                 case OPERATOR_GET_INDEX:
                     return "[arg]";
@@ -316,7 +339,7 @@ namespace wrenbind17 {
             }
         }
 
-        static std::string generateName(const ForeignMethodOperator name) {
+        static constexpr const char* generateName(const ForeignMethodOperator name) {
             switch (name) {
                 case OPERATOR_GET_INDEX:
                     return "[_]";
@@ -378,29 +401,29 @@ namespace wrenbind17 {
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     namespace detail {
-        template <typename... Args> inline std::string generateNameArgs() {
-            constexpr auto n = sizeof...(Args);
-            std::stringstream ss;
-            ss << "(";
-            for (size_t i = 0; i < n; i++) {
-                ss << "_";
-                if (i != n - 1) {
-                    ss << ",";
-                }
-            }
-            ss << ")";
-            return ss.str();
+        template <typename... Args> constexpr const char* generateNameArgs() {
+            return SignatureText<sizeof...(Args)>::names.data();
         }
 
         template <typename Signature, Signature signature> struct ForeignFunctionDetails;
 
-        template <typename R, typename... Args, R (*Fn)(Args...)> struct ForeignFunctionDetails<R (*)(Args...), Fn> {
+        template <typename R, typename... Args, bool NoExcept, R (*Fn)(Args...) noexcept(NoExcept)>
+        struct ForeignFunctionDetails<R (*)(Args...) noexcept(NoExcept), Fn> {
             typedef ForeignMethodImpl<Args...> ForeignMethodImplType;
+            typedef detail::ForeignFunctionCaller<R, Args...> Caller;
+
+            template <bool Unchecked = false> static WrenForeignMethodFn method() {
+                if constexpr (detail::useNoexceptCall<NoExcept, R, Args...>())
+                    return Caller::template callNoexcept<Fn, Unchecked>;
+                else
+                    return Caller::template call<Fn, Unchecked>;
+            }
 
+            template <bool Unchecked = false>
             static std::unique_ptr<ForeignMethodImplType> make(std::string name) {
                 auto signature = ForeignMethodImplType::generateSignature(name);
-                auto p = detail::ForeignFunctionCaller<R, Args...>::template call<Fn>;
-                name = name + detail::generateNameArgs<Args...>();
+                auto p = method<Unchecked>();
+                name += detail::generateNameArgs<Args...>();
                 return std::make_unique<ForeignMethodImplType>(std::move(name), std::move(signature), p, true);
             }
         };
@@ -426,7 +449,7 @@ namespace wrenbind17 {
      */
     template <typename T> class ForeignKlassImpl : public ForeignKlass {
     public:
-        ForeignKlassImpl(std::string name) : ForeignKlass(std::move(name)) {
+        ForeignKlassImpl(std::string name, WrenVM* vm = nullptr) : ForeignKlass(std::move(name)), vm(vm) {
             allocators.allocate = nullptr;
             allocators.finalize = &detail::ForeignKlassAllocator<T>::finalize;
         }
@@ -462,81 +485,101 @@ namespace wrenbind17 {
          */
         template <typename... Args> void ctor(const std::string& name = "new") {
             allocators.allocate = &detail::ForeignKlassAllocator<T, Args...>::allocate;
-            std::stringstream ss;
-            ss << "construct " << name << " (";
-            constexpr auto n = sizeof...(Args);
-            for (size_t i = 0; i < n; i++) {
-                if (i == 0)
-                    ss << "arg0";
-                else
-                    ss << ", arg" << i;
-            }
-            ss << ") {}\n\n";
-            ctorDef = ss.str();
+            ctorDef = "construct " + name + " " + detail::SignatureText<sizeof...(Args)>::params.data() + " {}\n\n";
         }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
         template <typename Signature, Signature signature> struct ForeignMethodDetails;
 
-        template <typename R, typename C, typename... Args, R (C::*Fn)(Args...)>
-        struct ForeignMethodDetails<R (C::*)(Args...), Fn> {
+        template <typename R, typename C, typename... Args, bool NoExcept, R (C::*Fn)(Args...) noexcept(NoExcept)>
+        struct ForeignMethodDetails<R (C::*)(Args...) noexcept(NoExcept), Fn> {
             static_assert(std::is_base_of<C, T>::value, "The method belong to its own class or a base class");
 
             typedef ForeignMethodImpl<Args...> ForeignMethodImplType;
+            typedef detail::ForeignMethodCaller<R, C, Args...> Caller;
+
+            template <bool Unchecked = false> static WrenForeignMethodFn method() {
+                if constexpr (detail::useNoexceptCall<NoExcept, R, Args...>())
+                    return Caller::template callNoexcept<Fn, Unchecked>;
+                else
+                    return Caller::template call<Fn, Unchecked>;
+            }
 
+            template <bool Unchecked = false>
             static std::unique_ptr<ForeignMethodImplType> make(std::string name) {
                 auto signature = ForeignMethodImplType::generateSignature(name);
-                auto p = detail::ForeignMethodCaller<R, C, Args...>::template call<Fn>;
-                name = name + detail::generateNameArgs<Args...>();
+                auto p = method<Unchecked>();
+                name += detail::generateNameArgs<Args...>();
                 return std::make_unique<ForeignMethodImplType>(std::move(name), std::move(signature), p, false);
             }
 
+            template <bool Unchecked = false>
             static std::unique_ptr<ForeignMethodImplType> make(const ForeignMethodOperator op) {
                 auto signature = ForeignMethodImplType::generateSignature(op);
                 auto name = ForeignMethodImplType::generateName(op);
-                auto p = detail::ForeignMethodCaller<R, C, Args...>::template call<Fn>;
+                auto p = method<Unchecked>();
                 return std::make_unique<ForeignMethodImplType>(std::move(name), std::move(signature), p, false);
             }
         };
 
-        template <typename R, typename C, typename... Args, R (C::*Fn)(Args...) const>
-        struct ForeignMethodDetails<R (C::*)(Args...) const, Fn> {
+        template <typename R, typename C, typename... Args, bool NoExcept, R (C::*Fn)(Args...) const noexcept(NoExcept)>
+        struct ForeignMethodDetails<R (C::*)(Args...) const noexcept(NoExcept), Fn> {
             static_assert(std::is_base_of<C, T>::value, "The method belong to its own class or a base class");
 
             typedef ForeignMethodImpl<Args...> ForeignMethodImplType;
+            typedef detail::ForeignMethodCaller<R, C, Args...> Caller;
+
+            template <bool Unchecked = false> static WrenForeignMethodFn method() {
+                if constexpr (detail::useNoexceptCall<NoExcept, R, Args...>())
+                    return Caller::template callNoexcept<Fn, Unchecked>;
+                else
+                    return Caller::template call<Fn, Unchecked>;
+            }
 
+            template <bool Unchecked = false>
             static std::unique_ptr<ForeignMethodImplType> make(std::string name) {
                 auto signature = ForeignMethodImplType::generateSignature(name);
-                auto p = detail::ForeignMethodCaller<R, C, Args...>::template call<Fn>;
-                name = name + detail::generateNameArgs<Args...>();
+                auto p = method<Unchecked>();
+                name += detail::generateNameArgs<Args...>();
                 return std::make_unique<ForeignMethodImplType>(std::move(name), std::move(signature), p, false);
             }
 
+            template <bool Unchecked = false>
             static std::unique_ptr<ForeignMethodImplType> make(const ForeignMethodOperator op) {
                 auto signature = ForeignMethodImplType::generateSignature(op);
                 auto name = ForeignMethodImplType::generateName(op);
-                auto p = detail::ForeignMethodCaller<R, C, Args...>::template call<Fn>;
+                auto p = method<Unchecked>();
                 return std::make_unique<ForeignMethodImplType>(std::move(name), std::move(signature), p, false);
             }
         };
 
         template <typename Signature, Signature signature> struct ForeignMethodExtDetails;
 
-        template <typename R, typename... Args, R (*Fn)(T&, Args...)>
-        struct ForeignMethodExtDetails<R (*)(T&, Args...), Fn> {
+        template <typename R, typename... Args, bool NoExcept, R (*Fn)(T&, Args...) noexcept(NoExcept)>
+        struct ForeignMethodExtDetails<R (*)(T&, Args...) noexcept(NoExcept), Fn> {
             typedef ForeignMethodImpl<Args...> ForeignMethodImplType;
+            typedef detail::ForeignMethodExtCaller<R, T, Args...> Caller;
+
+            template <bool Unchecked = false> static WrenForeignMethodFn method() {
+                if constexpr (detail::useNoexceptCall<NoExcept, R, Args...>())
+                    return Caller::template callNoexcept<Fn, Unchecked>;
+                else
+                    return Caller::template call<Fn, Unchecked>;
+            }
 
+            template <bool Unchecked = false>
             static std::unique_ptr<ForeignMethodImplType> make(std::string name) {
                 auto signature = ForeignMethodImplType::generateSignature(name);
-                auto p = detail::ForeignMethodExtCaller<R, T, Args...>::template call<Fn>;
-                name = name + detail::generateNameArgs<Args...>();
+                auto p = method<Unchecked>();
+                name += detail::generateNameArgs<Args...>();
                 return std::make_unique<ForeignMethodImplType>(std::move(name), std::move(signature), p, false);
             }
 
+            template <bool Unchecked = false>
             static std::unique_ptr<ForeignMethodImplType> make(const ForeignMethodOperator op) {
                 auto signature = ForeignMethodImplType::generateSignature(op);
                 auto name = ForeignMethodImplType::generateName(op);
-                auto p = detail::ForeignMethodExtCaller<R, T, Args...>::template call<Fn>;
+                auto p = method<Unchecked>();
                 return std::make_unique<ForeignMethodImplType>(std::move(name), std::move(signature), p, false);
             }
         };
@@ -562,45 +605,50 @@ namespace wrenbind17 {
 
         template <typename Signature, Signature signature> struct ForeignSetterDetails;
 
-        template <typename V, typename C, void (C::*Fn)(V)> struct ForeignSetterDetails<void (C::*)(V), Fn> {
+        template <typename V, typename C, bool NoExcept, void (C::*Fn)(V) noexcept(NoExcept)>
+        struct ForeignSetterDetails<void (C::*)(V) noexcept(NoExcept), Fn> {
             static_assert(std::is_base_of<C, T>::value, "The setter must belong to its own class or a base class");
 
             static WrenForeignMethodFn method() {
-                return detail::ForeignMethodCaller<void, C, V>::template call<Fn>;
+                return ForeignMethodDetails<void (C::*)(V) noexcept(NoExcept), Fn>::method();
             }
         };
 
         template <typename Signature, Signature signature> struct ForeignSetterExtDetails;
 
-        template <typename V, void (*Fn)(T&, V)> struct ForeignSetterExtDetails<void (*)(T&, V), Fn> {
+        template <typename V, bool NoExcept, void (*Fn)(T&, V) noexcept(NoExcept)>
+        struct ForeignSetterExtDetails<void (*)(T&, V) noexcept(NoExcept), Fn> {
             static WrenForeignMethodFn method() {
-                return detail::ForeignMethodExtCaller<void, T, V>::template call<Fn>;
+                return ForeignMethodExtDetails<void (*)(T&, V) noexcept(NoExcept), Fn>::method();
             }
         };
 
         template <typename Signature, Signature signature> struct ForeignGetterDetails;
 
-        template <typename R, typename C, R (C::*Fn)()> struct ForeignGetterDetails<R (C::*)(), Fn> {
+        template <typename R, typename C, bool NoExcept, R (C::*Fn)() noexcept(NoExcept)>
+        struct ForeignGetterDetails<R (C::*)() noexcept(NoExcept), Fn> {
             static_assert(std::is_base_of<C, T>::value, "The getter must belong to its own class or a base class");
 
             static WrenForeignMethodFn method() {
-                return detail::ForeignMethodCaller<R, C>::template call<Fn>;
+                return ForeignMethodDetails<R (C::*)() noexcept(NoExcept), Fn>::method();
             }
         };
 
-        template <typename R, typename C, R (C::*Fn)() const> struct ForeignGetterDetails<R (C::*)() const, Fn> {
+        template <typename R, typename C, bool NoExcept, R (C::*Fn)() const noexcept(NoExcept)>
+        struct ForeignGetterDetails<R (C::*)() const noexcept(NoExcept), Fn> {
             static_assert(std::is_base_of<C, T>::value, "The getter must belong to its own class or a base class");
 
             static WrenForeignMethodFn method() {
-                return detail::ForeignMethodCaller<R, C>::template call<Fn>;
+                return ForeignMethodDetails<R (C::*)() const noexcept(NoExcept), Fn>::method();
             }
         };
 
         template <typename Signature, Signature signature> struct ForeignGetterExtDetails;
 
-        template <typename R, R (*Fn)(T&)> struct ForeignGetterExtDetails<R (*)(T&), Fn> {
+        template <typename R, bool NoExcept, R (*Fn)(T&) noexcept(NoExcept)>
+        struct ForeignGetterExtDetails<R (*)(T&) noexcept(NoExcept), Fn> {
             static WrenForeignMethodFn method() {
-                return detail::ForeignMethodExtCaller<R, T>::template call<Fn>;
+                return ForeignMethodExtDetails<R (*)(T&) noexcept(NoExcept), Fn>::method();
             }
         };
 #endif
@@ -612,6 +660,8 @@ namespace wrenbind17 {
          * When this C++ function you are adding is called from Wren, it will check
          * the types passed and will match the C++ signature. If the types do not match
          * an exception is thrown that can be handled by Wren as a fiber.
+         * Pass wrenbind17::unchecked as the second template argument to skip
+         * the checks of bool, number, and string arguments.
          *
          * Example:
          *
@@ -640,8 +690,10 @@ namespace wrenbind17 {
          * }
          * @endcode
          */
-        template <auto Fn> void func(std::string name) {
-            auto ptr = ForeignMethodDetails<decltype(Fn), Fn>::make(std::move(name));
+        template <auto Fn, ArgumentCheck Check = detail::defaultArgumentCheck<T>()>
+        void func(std::string name) {
+            constexpr auto skipChecks = Check == ArgumentCheck::UNCHECKED;
+            auto ptr = ForeignMethodDetails<decltype(Fn), Fn>::template make<skipChecks>(std::move(name));
             methods.insert(std::make_pair(ptr->getName(), std::move(ptr)));
         }
 
@@ -679,8 +731,10 @@ namespace wrenbind17 {
          * }
          * @endcode
          */
-        template <auto Fn> void func(const ForeignMethodOperator name) {
-            auto ptr = ForeignMethodDetails<decltype(Fn), Fn>::make(name);
+        template <auto Fn, ArgumentCheck Check = detail::defaultArgumentCheck<T>()>
+        void func(const ForeignMethodOperator name) {
+            constexpr auto skipChecks = Check == ArgumentCheck::UNCHECKED;
+            auto ptr = ForeignMethodDetails<decltype(Fn), Fn>::template make<skipChecks>(name);
             methods.insert(std::make_pair(ptr->getName(), std::move(ptr)));
         }
 
@@ -726,8 +780,10 @@ namespace wrenbind17 {
          * }
          * @endcode
          */
-        template <auto Fn> void funcExt(std::string name) {
-            auto ptr = ForeignMethodExtDetails<decltype(Fn), Fn>::make(std::move(name));
+        template <auto Fn, ArgumentCheck Check = detail::defaultArgumentCheck<T>()>
+        void funcExt(std::string name) {
+            constexpr auto skipChecks = Check == ArgumentCheck::UNCHECKED;
+            auto ptr = ForeignMethodExtDetails<decltype(Fn), Fn>::template make<skipChecks>(std::move(name));
             methods.insert(std::make_pair(ptr->getName(), std::move(ptr)));
         }
 
@@ -736,8 +792,10 @@ namespace wrenbind17 {
          * @see ForeignMethodOperator
          * @details Same as funcExt but instead it can accept an operator enumeration.
          */
-        template <auto Fn> void funcExt(const ForeignMethodOperator name) {
-            auto ptr = ForeignMethodExtDetails<decltype(Fn), Fn>::make(name);
+        template <auto Fn, ArgumentCheck Check = detail::defaultArgumentCheck<T>()>
+        void funcExt(const ForeignMethodOperator name) {
+            constexpr auto skipChecks = Check == ArgumentCheck::UNCHECKED;
+            auto ptr = ForeignMethodExtDetails<decltype(Fn), Fn>::template make<skipChecks>(name);
             methods.insert(std::make_pair(ptr->getName(), std::move(ptr)));
         }
 
@@ -779,8 +837,10 @@ namespace wrenbind17 {
          * }
          * @endcode
          */
-        template <auto Fn> void funcStatic(std::string name) {
-            auto ptr = detail::ForeignFunctionDetails<decltype(Fn), Fn>::make(std::move(name));
+        template <auto Fn, ArgumentCheck Check = detail::defaultArgumentCheck<T>()>
+        void funcStatic(std::string name) {
+            constexpr auto skipChecks = Check == ArgumentCheck::UNCHECKED;
+            auto ptr = detail::ForeignFunctionDetails<decltype(Fn), Fn>::template make<skipChecks>(std::move(name));
             methods.insert(std::make_pair(ptr->getName(), std::move(ptr)));
         }
 
@@ -823,10 +883,12 @@ namespace wrenbind17 {
          * }
          * @endcode
          */
-        template <auto Fn> void funcStaticExt(std::string name) {
+        template <auto Fn, ArgumentCheck Check = detail::defaultArgumentCheck<T>()>
+        void funcStaticExt(std::string name) {
             // This is exactly the same as funcStatic because there is
             // no difference for "static void Foo::foo(){}" and "void foo(){}"!
-            auto ptr = detail::ForeignFunctionDetails<decltype(Fn), Fn>::make(std::move(name));
+            constexpr auto skipChecks = Check == ArgumentCheck::UNCHECKED;
+            auto ptr = detail::ForeignFunctionDetails<decltype(Fn), Fn>::template make<skipChecks>(std::move(name));
             methods.insert(std::make_pair(ptr->getName(), std::move(ptr)));
         }
 
@@ -1035,5 +1097,47 @@ namespace wrenbind17 {
             auto ptr = std::make_unique<ForeignProp>(std::move(name), g, nullptr, false);
             props.insert(std::make_pair(ptr->getName(), std::move(ptr)));
         }
+
+        /*!
+         * @brief Pushing the same C++ instance into Wren again returns the same Wren object
+         * @details Applies to instances pushed via a pointer, a reference, or a shared pointer.
+         * This keeps the identity of the object in Wren (the == operator) and avoids creating
+         * a new Wren object each time. An instance pushed via a pointer or a reference is borrowed,
+         * its Wren object is never returned for a shared pointer of the same instance.
+         *
+         * The Wren API has no weak references, therefore the VM holds the remembered Wren objects.
+         * At most borrowedLimit Wren objects of borrowed instances are remembered, the least recently
+         * pushed ones are forgotten first. Forget them sooner via VM::releaseIdentity() with the same
+         * pointer, for example when the C++ instance is being destroyed, or VM::releaseIdentities().
+         * The Wren object of a shared instance is forgotten by VM::gc() (or when more instances are
+         * added) once no C++ shared pointer owns the instance anymore, so this does not keep the
+         * instance alive. If C++ gets such an instance back from Wren as a shared pointer, the same
+         * Wren object is remembered again.
+         * @param borrowedLimit The maximum number of remembered borrowed instances, zero remembers
+         * only shared instances
+         * @code
+         * auto& cls = m.klass<Player>("Player");
+         * cls.identity();
+         * @endcode
+         */
+        void identity(const size_t borrowedLimit = 256) {
+            enableIdentity(vm, typeid(T).hash_code(), borrowedLimit);
+        }
+
+        /*!
+         * @brief Destroy the C++ instances later via VM::drainReleases() instead of during garbage collection
+         * @details Wren destroys foreign objects while it collects the garbage. If the class
+         * has an expensive destructor (textures, large containers, etc.) collecting many of them
+         * at once causes a long pause. With this enabled, the garbage collector only moves the
+         * shared pointer into the queue of this VM. The queue can be drained from any thread.
+         * @note The instances are not destroyed until you call VM::drainReleases() or destroy the VM.
+         */
+        void deferRelease() {
+            enableDeferredRelease(vm, typeid(T).hash_code());
+            allocators.finalize = &detail::ForeignKlassAllocator<T>::finalizeDeferred;
+        }
+
+    private:
+        WrenVM* vm;
     };
 } // namespace wrenbind17
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "method.hpp"
+#include "pop.hpp"
+#include "push.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief Holds native Wren list
+     * @details Use VM::createList() to create a new list, or get an existing one
+     * from Wren via Any::as<List>() or as a function argument.
+     */
+    class List {
+    public:
+        List() {
+        }
+        List(const std::shared_ptr<Handle>& handle) : handle(handle) {
+        }
+        ~List() {
+            reset();
+        }
+
+        Handle& getHandle() {
+            return *handle;
+        }
+
+        const Handle& getHandle() const {
+            return *handle;
+        }
+
+        operator bool() const {
+            return handle.operator bool();
+        }
+
+        void reset() {
+            handle.reset();
+        }
+
+        /*!
+         * @brief Returns the size of the list
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         */
+        size_t count() const {
+            auto* vm = lock(1);
+            return static_cast<size_t>(wrenGetListCount(vm, 0));
+        }
+
+        /*!
+         * @brief Returns a value specified by T from the list by an index
+         * @throws std::out_of_range if the index is not within the list
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         */
+        template <typename T> T get(const size_t index) const {
+            auto* vm = lock(2);
+            checkIndex(vm, index);
+            wrenGetListElement(vm, 0, static_cast<int>(index), 1);
+            return detail::PopHelper<T>::f(vm, 1);
+        }
+
+        /*!
+         * @brief Replaces a value in the list at an index
+         * @throws std::out_of_range if the index is not within the list
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         * @warning If using strings, make sure that you use std::string because
+         * raw C-strings are not allowed.
+         */
+        template <typename T> void set(const size_t index, const T& value) {
+            auto* vm = lock(2);
+            checkIndex(vm, index);
+            detail::PushHelper<T>::f(vm, 1, value);
+            wrenSetListElement(vm, 0, static_cast<int>(index), 1);
+        }
+
+        /*!
+         * @brief Adds a value to the end of the list
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         * @warning If using strings, make sure that you use std::string because
+         * raw C-strings are not allowed.
+         */
+        template <typename T> void append(const T& value) {
+            auto* vm = lock(2);
+            detail::PushHelper<T>::f(vm, 1, value);
+            wrenInsertInList(vm, 0, -1, 1);
+        }
+
+        /*!
+         * @brief Inserts a value before an index, the index can be equal to the size of the list
+         * @throws std::out_of_range if the index is greater than the size of the list
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         */
+        template <typename T> void insert(const size_t index, const T& value) {
+            auto* vm = lock(2);
+            if (index > static_cast<size_t>(wrenGetListCount(vm, 0)))
+                throw std::out_of_range("List index out of range");
+            detail::PushHelper<T>::f(vm, 1, value);
+            wrenInsertInList(vm, 0, static_cast<int>(index), 1);
+        }
+
+        /*!
+         * @brief Removes a value from the list at an index
+         * @details The Wren API has no function to remove list elements, this calls
+         * the Wren removeAt(_) method instead. Do not call this from within a foreign function.
+         * @throws std::out_of_range if the index is not within the list
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         */
+        void removeAt(const size_t index) {
+            auto* vm = lock(2);
+            checkIndex(vm, index);
+            auto* method = wrenMakeCallHandle(vm, "removeAt(_)");
+            wrenSetSlotDouble(vm, 1, static_cast<double>(index));
+            const auto result = wrenCall(vm, method);
+            wrenReleaseHandle(vm, method);
+            if (result != WREN_RESULT_SUCCESS) {
+                throw RuntimeError(getLastError(vm));
+            }
+        }
+
+        /*!
+         * @brief Appends all values from the range to the end of the list
+         * @details The list is locked and positioned into a slot only once for the entire range.
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         */
+        template <typename Iter> void appendRange(Iter begin, Iter end) {
+            using T = typename std::iterator_traits<Iter>::value_type;
+            auto* vm = lock(2);
+            for (auto it = begin; it != end; ++it) {
+                detail::PushHelper<T>::f(vm, 1, *it);
+                wrenInsertInList(vm, 0, -1, 1);
+            }
+        }
+
+        /*!
+         * @brief Copies values from the beginning of the list into a contiguous container
+         * @details The output can be anything with data() and size(), for example
+         * std::vector, std::array, std::span, or Buffer. The size of the output is not changed.
+         * @returns The number of the copied values
+         * @throws BadCast if some value is not the expected type
+         * @throws RuntimeError if this is an invalid list or the Wren VM has terminated
+         */
+        template <typename Container> size_t copyTo(Container& out) const {
+            using T = typename std::remove_const<typename std::remove_pointer<decltype(out.data())>::type>::type;
+            auto* vm = lock(2);
+            const auto size = std::min(static_cast<size_t>(wrenGetListCount(vm, 0)), out.size());
+            auto* data = out.data();
+            if constexpr (detail::is_list_number<T>::value) {
+                detail::loopAndPopNumbers(vm, 0, data, size);
+            } else {
+                for (size_t i = 0; i < size; i++) {
+                    wrenGetListElement(vm, 0, static_cast<int>(i), 1);
+                    data[i] = detail::PopHelper<T>::f(vm, 1);
+                }
+            }
+            return size;
+        }
+
+    private:
+        WrenVM* lock(const int slots) const {
+            if (const auto ptr = handle->getVmWeak().lock()) {
+                wrenEnsureSlots(ptr.get(), slots);
+                wrenSetSlotHandle(ptr.get(), 0, handle->getHandle());
+                return ptr.get();
+            } else {
+                throw RuntimeError("Invalid handle");
+            }
+        }
+
+        static void checkIndex(WrenVM* vm, const size_t index) {
+            if (index >= static_cast<size_t>(wrenGetListCount(vm, 0)))
+                throw std::out_of_range("List index out of range");
+        }
+
+        std::shared_ptr<Handle> handle;
+    };
+
+    template <> inline List detail::getSlot<List>(WrenVM* vm, const int idx) {
+        validate<WrenType::WREN_TYPE_LIST>(vm, idx);
+        return List(std::make_shared<Handle>(getSharedVm(vm), wrenGetSlotHandle(vm, idx)));
+    }
+
+    template <> inline bool detail::is<List>(WrenVM* vm, const int idx) {
+        return wrenGetSlotType(vm, idx) == WREN_TYPE_LIST;
+    }
+
+    template <> inline void detail::PushHelper<List>::f(WrenVM* vm, int idx, const List& value) {
+        wrenSetSlotHandle(value.getHandle().getVm(), idx, value.getHandle().getHandle());
+    }
+
+    template <> inline void detail::PushHelper<List>::f(WrenVM* vm, int idx, List&& value) {
+        wrenSetSlotHandle(value.getHandle().getVm(), idx, value.getHandle().getHandle());
+    }
+
+    template <> inline void detail::PushHelper<const List>::f(WrenVM* vm, int idx, const List value) {
+        wrenSetSlotHandle(value.getHandle().getVm(), idx, value.getHandle().getHandle());
+    }
+
+    template <> inline void detail::PushHelper<const List&>::f(WrenVM* vm, int idx, const List& value) {
+        wrenSetSlotHandle(value.getHandle().getVm(), idx, value.getHandle().getHandle());
+    }
+
+    template <> inline void detail::PushHelper<List&>::f(WrenVM* vm, int idx, List& value) {
+        wrenSetSlotHandle(value.getHandle().getVm(), idx, value.getHandle().getHandle());
+    }
+} // namespace wrenbind17
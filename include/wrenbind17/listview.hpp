@@ -0,0 +1,189 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <iterator>
+#include <stdexcept>
+
+#include "pop.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief A read-only view of a native Wren list passed as a function argument
+     * @details Unlike std::vector, nothing is copied when the function is called.
+     * Each element is converted into T only when accessed. Use this as a parameter
+     * type of a bound function when the function only needs few elements of the list.
+     * @warning The view is only valid during the call of the function it was passed to.
+     * Do not store it anywhere.
+     */
+    template <typename T> class ListView {
+    public:
+        class Iterator {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T* pointer;
+            typedef T reference;
+
+            Iterator(const ListView* view, const size_t index) : view(view), index(index) {
+            }
+
+            T operator*() const {
+                return (*view)[index];
+            }
+
+            T operator[](const difference_type n) const {
+                return (*view)[index + n];
+            }
+
+            Iterator& operator++() {
+                ++index;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto copy = *this;
+                ++index;
+                return copy;
+            }
+
+            Iterator& operator--() {
+                --index;
+                return *this;
+            }
+
+            Iterator operator--(int) {
+                auto copy = *this;
+                --index;
+                return copy;
+            }
+
+            Iterator& operator+=(const difference_type n) {
+                index += n;
+                return *this;
+            }
+
+            Iterator& operator-=(const difference_type n) {
+                index -= n;
+                return *this;
+            }
+
+            Iterator operator+(const difference_type n) const {
+                return Iterator(view, index + n);
+            }
+
+            Iterator operator-(const difference_type n) const {
+                return Iterator(view, index - n);
+            }
+
+            difference_type operator-(const Iterator& other) const {
+                return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+            }
+
+            bool operator==(const Iterator& other) const {
+                return index == other.index;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return index != other.index;
+            }
+
+            bool operator<(const Iterator& other) const {
+                return index < other.index;
+            }
+
+        private:
+            const ListView* view;
+            size_t index;
+        };
+
+        ListView() = default;
+
+        /*!
+         * @brief Creates a view of the list in a specific slot
+         * @details A scratch slot past all current slots is reserved for the conversion
+         * of the elements.
+         */
+        ListView(WrenVM* vm, const int slot) : vm(vm), slot(slot) {
+            length = static_cast<size_t>(wrenGetListCount(vm, slot));
+            scratch = wrenGetSlotCount(vm);
+            wrenEnsureSlots(vm, scratch + 1);
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        bool empty() const {
+            return length == 0;
+        }
+
+        /*!
+         * @brief Converts an element of the list without bounds checking
+         * @throws BadCast if the element is not the type T
+         */
+        T operator[](const size_t index) const {
+            wrenGetListElement(vm, slot, static_cast<int>(index), scratch);
+            return detail::PopHelper<T>::f(vm, scratch);
+        }
+
+        /*!
+         * @brief Converts an element of the list with bounds checking
+         * @throws std::out_of_range if the index is not within the list
+         * @throws BadCast if the element is not the type T
+         */
+        T at(const size_t index) const {
+            if (index >= length)
+                throw std::out_of_range("ListView index out of range");
+            return (*this)[index];
+        }
+
+        Iterator begin() const {
+            return Iterator(this, 0);
+        }
+
+        Iterator end() const {
+            return Iterator(this, length);
+        }
+
+    private:
+        WrenVM* vm{nullptr};
+        int slot{0};
+        int scratch{0};
+        size_t length{0};
+    };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        template <typename T> struct PopHelper<ListView<T>> {
+            static inline ListView<T> f(WrenVM* vm, const int idx) {
+                validate<WrenType::WREN_TYPE_LIST>(vm, idx);
+                return ListView<T>(vm, idx);
+            }
+        };
+
+        template <typename T> struct PopHelper<const ListView<T>&> {
+            static inline ListView<T> f(WrenVM* vm, const int idx) {
+                return PopHelper<ListView<T>>::f(vm, idx);
+            }
+        };
+
+        template <typename T> struct CheckSlot<ListView<T>> {
+            static bool f(WrenVM* vm, const int idx) {
+                return wrenGetSlotType(vm, idx) == WrenType::WREN_TYPE_LIST;
+            }
+        };
+
+        template <typename T> struct CheckSlot<const ListView<T>&> {
+            static bool f(WrenVM* vm, const int idx) {
+                return wrenGetSlotType(vm, idx) == WrenType::WREN_TYPE_LIST;
+            }
+        };
+    } // namespace detail
+#endif
+} // namespace wrenbind17
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "method.hpp"
 #include "pop.hpp"
 #include "push.hpp"
@@ -67,17 +69,74 @@ namespace wrenbind17 {
          * does not matter as long as Wren map supports that key type.
          */
         template <typename T, typename Key> T get(const Key& key) const {
-            if (const auto ptr = handle->getVmWeak().lock()) {
-                wrenEnsureSlots(ptr.get(), 3);
-                wrenSetSlotHandle(ptr.get(), 0, handle->getHandle());
-                detail::PushHelper<Key>::f(ptr.get(), 1, key);
-                if (!wrenGetMapContainsKey(ptr.get(), 0, 1)) {
-                    throw NotFound();
+            auto* vm = lock(3);
+            if (!lookup(vm, key)) {
+                throw NotFound();
+            }
+            return detail::PopHelper<T>::f(vm, 2);
+        }
+
+        /*!
+         * @brief Returns a value specified by T from the map by a key, or nothing if the key does not exist
+         * @throws RuntimeError if this is an invalid map or the Wren VM has terminated
+         * @throws BadCast if the value is not the type T
+         * @warning If using strings, make sure that you use std::string because
+         * raw C-strings are not allowed.
+         */
+        template <typename T, typename Key> std::optional<T> tryGet(const Key& key) const {
+            auto* vm = lock(3);
+            if (!lookup(vm, key)) {
+                return std::nullopt;
+            }
+            return detail::PopHelper<T>::f(vm, 2);
+        }
+
+        /*!
+         * @brief Looks up multiple keys at once
+         * @details The map is positioned into a slot only once for all of the keys.
+         * The found values are assigned into the output map (or anything with insert_or_assign)
+         * and the keys that do not exist are skipped.
+         * @returns The number of found keys
+         * @throws RuntimeError if this is an invalid map or the Wren VM has terminated
+         * @throws BadCast if some value is not the type of the output
+         */
+        template <typename Keys, typename Out> size_t getMany(const Keys& keys, Out& out) const {
+            using T = typename Out::mapped_type;
+            auto* vm = lock(3);
+            size_t found = 0;
+            for (const auto& key : keys) {
+                if (lookup(vm, key)) {
+                    out.insert_or_assign(key, detail::PopHelper<T>::f(vm, 2));
+                    ++found;
                 }
-                wrenGetMapValue(ptr.get(), 0, 1, 2);
-                return detail::PopHelper<T>::f(ptr.get(), 2);
-            } else {
-                throw RuntimeError("Invalid handle");
+            }
+            return found;
+        }
+
+        /*!
+         * @brief Sets a value for a key, the key is created if it does not exist
+         * @throws RuntimeError if this is an invalid map or the Wren VM has terminated
+         * @warning If using strings, make sure that you use std::string because
+         * raw C-strings are not allowed.
+         */
+        template <typename Key, typename T> void set(const Key& key, const T& value) {
+            auto* vm = lock(3);
+            detail::PushHelper<Key>::f(vm, 1, key);
+            detail::PushHelper<T>::f(vm, 2, value);
+            wrenSetMapValue(vm, 0, 1, 2);
+        }
+
+        /*!
+         * @brief Sets all key-value pairs from a range, such as std::map or std::vector of std::pair
+         * @details The map is positioned into a slot only once for all of the pairs.
+         * @throws RuntimeError if this is an invalid map or the Wren VM has terminated
+         */
+        template <typename Range> void setMany(const Range& range) {
+            auto* vm = lock(3);
+            for (const auto& pair : range) {
+                detail::PushHelper<typename std::remove_const<decltype(pair.first)>::type>::f(vm, 1, pair.first);
+                detail::PushHelper<typename std::remove_const<decltype(pair.second)>::type>::f(vm, 2, pair.second);
+                wrenSetMapValue(vm, 0, 1, 2);
             }
         }
 
@@ -118,6 +177,27 @@ namespace wrenbind17 {
         }
 
     private:
+        WrenVM* lock(const int slots) const {
+            if (const auto ptr = handle->getVmWeak().lock()) {
+                wrenEnsureSlots(ptr.get(), slots);
+                wrenSetSlotHandle(ptr.get(), 0, handle->getHandle());
+                return ptr.get();
+            } else {
+                throw RuntimeError("Invalid handle");
+            }
+        }
+
+        // Puts the value into the slot 2, the map must be in the slot 0
+        template <typename Key> static bool lookup(WrenVM* vm, const Key& key) {
+            detail::PushHelper<Key>::f(vm, 1, key);
+            wrenGetMapValue(vm, 0, 1, 2);
+            // A missing key also gives null, only then the second lookup is needed
+            if (wrenGetSlotType(vm, 2) == WrenType::WREN_TYPE_NULL) {
+                return wrenGetMapContainsKey(vm, 0, 1);
+            }
+            return true;
+        }
+
         std::shared_ptr<Handle> handle;
     };
 
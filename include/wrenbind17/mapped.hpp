@@ -0,0 +1,257 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#define WRENBIND17_UNDEF_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef WRENBIND17_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef WRENBIND17_UNDEF_NOMINMAX
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "buffer.hpp"
+#include "module.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief A read-only memory mapped file shared by the whole process
+     * @details Use MappedFile::open() to get the file. Opening the same file twice,
+     * even from different VMs, returns the same mapping, so the data lives only once
+     * in the page cache no matter how many VMs read it. The file is unmapped once
+     * the last shared pointer, or the last view created from it, is destroyed.
+     * Use MappedFileBindings to register the class into Wren.
+     */
+    class MappedFile : public std::enable_shared_from_this<MappedFile> {
+    public:
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile& operator=(MappedFile&& other) = delete;
+
+        ~MappedFile() {
+#ifdef _WIN32
+            if (ptr) {
+                UnmapViewOfFile(ptr);
+            }
+#else
+            if (ptr) {
+                munmap(const_cast<uint8_t*>(ptr), length);
+            }
+#endif
+        }
+
+        /*!
+         * @brief Maps the file or returns an existing mapping of the same file
+         * @throws Exception if the file can not be opened or mapped
+         */
+        static std::shared_ptr<MappedFile> open(const std::string& path) {
+            const auto key = canonicalPath(path);
+
+            static std::mutex mutex;
+            static std::unordered_map<std::string, std::weak_ptr<MappedFile>> cache;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(key);
+            if (it != cache.end()) {
+                if (auto existing = it->second.lock()) {
+                    return existing;
+                }
+            }
+
+            std::shared_ptr<MappedFile> file(new MappedFile(key));
+            cache[key] = file;
+
+            // Drop the entries of files that are no longer mapped
+            for (auto i = cache.begin(); i != cache.end();) {
+                if (i->second.expired())
+                    i = cache.erase(i);
+                else
+                    ++i;
+            }
+
+            return file;
+        }
+
+        const std::string& getPath() const {
+            return path;
+        }
+
+        const uint8_t* data() const {
+            return ptr;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        /*!
+         * @brief Reads a value at a specific byte offset
+         * @details The offset does not need to be aligned.
+         * @throws std::out_of_range if the value does not fit within the file
+         */
+        template <typename T> T read(const size_t offset) const {
+            static_assert(std::is_trivially_copyable<T>::value, "MappedFile can only read trivial types");
+            checkRange(offset, sizeof(T));
+            T value;
+            std::memcpy(&value, ptr + offset, sizeof(T));
+            return value;
+        }
+
+        /*!
+         * @brief Returns a read-only buffer over a part of the file
+         * @details The buffer does not copy the data and keeps this file mapped
+         * for as long as the buffer exists.
+         * @throws std::out_of_range if the view does not fit within the file
+         * @throws Exception if the offset is not aligned for the type
+         */
+        template <typename T> Buffer<T> view(const size_t offset, const size_t count) const {
+            if (count > length / sizeof(T))
+                throw std::out_of_range("MappedFile offset out of range");
+            checkRange(offset, count * sizeof(T));
+            if (reinterpret_cast<uintptr_t>(ptr + offset) % alignof(T) != 0)
+                throw Exception("MappedFile view offset is not aligned");
+            return Buffer<T>(reinterpret_cast<const T*>(ptr + offset), count, shared_from_this());
+        }
+
+    private:
+        explicit MappedFile(std::string file) : path(std::move(file)) {
+#ifdef _WIN32
+            auto handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == INVALID_HANDLE_VALUE)
+                throw Exception("Failed to open file: " + path);
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(handle, &fileSize)) {
+                CloseHandle(handle);
+                throw Exception("Failed to get size of file: " + path);
+            }
+            length = static_cast<size_t>(fileSize.QuadPart);
+
+            if (length) {
+                auto mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(handle);
+                if (!mapping)
+                    throw Exception("Failed to map file: " + path);
+                ptr = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+                if (!ptr)
+                    throw Exception("Failed to map file: " + path);
+            } else {
+                CloseHandle(handle);
+            }
+#else
+            const auto fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw Exception("Failed to open file: " + path);
+
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw Exception("Failed to get size of file: " + path);
+            }
+            length = static_cast<size_t>(st.st_size);
+
+            // Zero sized mappings are not allowed
+            if (length) {
+                auto* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (addr == MAP_FAILED)
+                    throw Exception("Failed to map file: " + path);
+                ptr = static_cast<const uint8_t*>(addr);
+            } else {
+                ::close(fd);
+            }
+#endif
+        }
+
+        static std::string canonicalPath(const std::string& path) {
+#ifdef _WIN32
+            char buffer[MAX_PATH];
+            if (_fullpath(buffer, path.c_str(), MAX_PATH))
+                return std::string(buffer);
+#else
+            if (auto* res = realpath(path.c_str(), nullptr)) {
+                std::string str(res);
+                std::free(res);
+                return str;
+            }
+#endif
+            return path;
+        }
+
+        void checkRange(const size_t offset, const size_t size) const {
+            if (offset > length || size > length - offset)
+                throw std::out_of_range("MappedFile offset out of range");
+        }
+
+        std::string path;
+        const uint8_t* ptr{nullptr};
+        size_t length{0};
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Registers MappedFile as a foreign class
+     * @details Scripts can not open files on their own, the files are opened in C++ via
+     * MappedFile::open() and passed into Wren, so the application decides which files
+     * a script can read. Scripts read the file via bounds checked typed reads or read-only
+     * buffer views. The views need the buffer classes registered by bindBuffers() in the same module.
+     */
+    class MappedFileBindings {
+    public:
+        static size_t count(MappedFile& self) {
+            return self.size();
+        }
+
+        template <typename T> static T read(MappedFile& self, size_t offset) {
+            return self.read<T>(offset);
+        }
+
+        template <typename T> static Buffer<T> view(MappedFile& self, size_t offset, size_t count) {
+            return self.view<T>(offset, count);
+        }
+
+        static void bind(ForeignModule& m, const std::string& name) {
+            auto& cls = m.klass<MappedFile>(name);
+            cls.propReadonlyExt<&MappedFileBindings::count>("count");
+
+            cls.funcExt<&MappedFileBindings::read<uint8_t>>("readUint8");
+            cls.funcExt<&MappedFileBindings::read<int8_t>>("readInt8");
+            cls.funcExt<&MappedFileBindings::read<uint16_t>>("readUint16");
+            cls.funcExt<&MappedFileBindings::read<int16_t>>("readInt16");
+            cls.funcExt<&MappedFileBindings::read<uint32_t>>("readUint32");
+            cls.funcExt<&MappedFileBindings::read<int32_t>>("readInt32");
+            cls.funcExt<&MappedFileBindings::read<float>>("readFloat32");
+            cls.funcExt<&MappedFileBindings::read<double>>("readFloat64");
+
+            cls.funcExt<&MappedFileBindings::view<uint8_t>>("bytes");
+            cls.funcExt<&MappedFileBindings::view<int32_t>>("int32View");
+            cls.funcExt<&MappedFileBindings::view<float>>("float32View");
+            cls.funcExt<&MappedFileBindings::view<double>>("float64View");
+        }
+    };
+} // namespace wrenbind17
@@ -0,0 +1,669 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WRENBIND17_MATH_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define WRENBIND17_MATH_NEON 1
+#endif
+
+#include "buffer.hpp"
+#include "module.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        // Kernels over 4 floats aligned to 16 bytes
+        inline void simdAdd4(const float* a, const float* b, float* out) {
+#if defined(WRENBIND17_MATH_SSE2)
+            _mm_store_ps(out, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b)));
+#elif defined(WRENBIND17_MATH_NEON)
+            vst1q_f32(out, vaddq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+            for (int i = 0; i < 4; i++)
+                out[i] = a[i] + b[i];
+#endif
+        }
+
+        inline void simdSub4(const float* a, const float* b, float* out) {
+#if defined(WRENBIND17_MATH_SSE2)
+            _mm_store_ps(out, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b)));
+#elif defined(WRENBIND17_MATH_NEON)
+            vst1q_f32(out, vsubq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+            for (int i = 0; i < 4; i++)
+                out[i] = a[i] - b[i];
+#endif
+        }
+
+        inline void simdMul4(const float* a, const float* b, float* out) {
+#if defined(WRENBIND17_MATH_SSE2)
+            _mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)));
+#elif defined(WRENBIND17_MATH_NEON)
+            vst1q_f32(out, vmulq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+            for (int i = 0; i < 4; i++)
+                out[i] = a[i] * b[i];
+#endif
+        }
+
+        inline void simdScale4(const float* a, const float s, float* out) {
+#if defined(WRENBIND17_MATH_SSE2)
+            _mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_set1_ps(s)));
+#elif defined(WRENBIND17_MATH_NEON)
+            vst1q_f32(out, vmulq_n_f32(vld1q_f32(a), s));
+#else
+            for (int i = 0; i < 4; i++)
+                out[i] = a[i] * s;
+#endif
+        }
+
+        inline float simdDot4(const float* a, const float* b) {
+#if defined(WRENBIND17_MATH_SSE2)
+            const auto m = _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b));
+            auto shuf = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1));
+            auto sums = _mm_add_ps(m, shuf);
+            shuf = _mm_movehl_ps(shuf, sums);
+            sums = _mm_add_ss(sums, shuf);
+            return _mm_cvtss_f32(sums);
+#elif defined(WRENBIND17_MATH_NEON)
+            const auto m = vmulq_f32(vld1q_f32(a), vld1q_f32(b));
+            auto sums = vadd_f32(vget_low_f32(m), vget_high_f32(m));
+            sums = vpadd_f32(sums, sums);
+            return vget_lane_f32(sums, 0);
+#else
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+#endif
+        }
+
+        // Column major matrix times a vector, the vector does not need to be aligned
+        inline void simdTransform4(const float* m, const float* v, float* out) {
+#if defined(WRENBIND17_MATH_SSE2)
+            auto res = _mm_mul_ps(_mm_load_ps(m), _mm_set1_ps(v[0]));
+            res = _mm_add_ps(res, _mm_mul_ps(_mm_load_ps(m + 4), _mm_set1_ps(v[1])));
+            res = _mm_add_ps(res, _mm_mul_ps(_mm_load_ps(m + 8), _mm_set1_ps(v[2])));
+            res = _mm_add_ps(res, _mm_mul_ps(_mm_load_ps(m + 12), _mm_set1_ps(v[3])));
+            _mm_storeu_ps(out, res);
+#elif defined(WRENBIND17_MATH_NEON)
+            auto res = vmulq_n_f32(vld1q_f32(m), v[0]);
+            res = vmlaq_n_f32(res, vld1q_f32(m + 4), v[1]);
+            res = vmlaq_n_f32(res, vld1q_f32(m + 8), v[2]);
+            res = vmlaq_n_f32(res, vld1q_f32(m + 12), v[3]);
+            vst1q_f32(out, res);
+#else
+            float res[4];
+            for (int i = 0; i < 4; i++)
+                res[i] = m[i] * v[0] + m[4 + i] * v[1] + m[8 + i] * v[2] + m[12 + i] * v[3];
+            for (int i = 0; i < 4; i++)
+                out[i] = res[i];
+#endif
+        }
+    } // namespace detail
+#endif
+
+    /**
+     * @ingroup wrenbind17
+     * @brief A two component vector
+     */
+    struct alignas(8) Vec2 {
+        float x{0.0f};
+        float y{0.0f};
+
+        Vec2() = default;
+        Vec2(const float x, const float y) : x(x), y(y) {
+        }
+
+        Vec2 operator+(const Vec2& other) const {
+            return Vec2(x + other.x, y + other.y);
+        }
+        Vec2 operator-(const Vec2& other) const {
+            return Vec2(x - other.x, y - other.y);
+        }
+        Vec2 operator*(const float s) const {
+            return Vec2(x * s, y * s);
+        }
+        Vec2 operator-() const {
+            return Vec2(-x, -y);
+        }
+        bool operator==(const Vec2& other) const {
+            return x == other.x && y == other.y;
+        }
+        bool operator!=(const Vec2& other) const {
+            return !(*this == other);
+        }
+        Vec2 mul(const Vec2& other) const {
+            return Vec2(x * other.x, y * other.y);
+        }
+        float dot(const Vec2& other) const {
+            return x * other.x + y * other.y;
+        }
+        float length() const {
+            return std::sqrt(dot(*this));
+        }
+        Vec2 normalized() const {
+            const auto len = length();
+            return len > 0.0f ? *this * (1.0f / len) : *this;
+        }
+        void addAssign(const Vec2& other) {
+            x += other.x;
+            y += other.y;
+        }
+        void subAssign(const Vec2& other) {
+            x -= other.x;
+            y -= other.y;
+        }
+        void mulAssign(const float s) {
+            x *= s;
+            y *= s;
+        }
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief A three component vector, padded to 16 bytes for SIMD
+     */
+    struct alignas(16) Vec3 {
+        float x{0.0f};
+        float y{0.0f};
+        float z{0.0f};
+        float padding{0.0f};
+
+        Vec3() = default;
+        Vec3(const float x, const float y, const float z) : x(x), y(y), z(z) {
+        }
+
+        Vec3 operator+(const Vec3& other) const {
+            Vec3 res;
+            detail::simdAdd4(&x, &other.x, &res.x);
+            return res;
+        }
+        Vec3 operator-(const Vec3& other) const {
+            Vec3 res;
+            detail::simdSub4(&x, &other.x, &res.x);
+            return res;
+        }
+        Vec3 operator*(const float s) const {
+            Vec3 res;
+            detail::simdScale4(&x, s, &res.x);
+            return res;
+        }
+        Vec3 operator-() const {
+            return *this * -1.0f;
+        }
+        bool operator==(const Vec3& other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+        bool operator!=(const Vec3& other) const {
+            return !(*this == other);
+        }
+        Vec3 mul(const Vec3& other) const {
+            Vec3 res;
+            detail::simdMul4(&x, &other.x, &res.x);
+            return res;
+        }
+        float dot(const Vec3& other) const {
+            return detail::simdDot4(&x, &other.x);
+        }
+        Vec3 cross(const Vec3& other) const {
+            return Vec3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
+        }
+        float length() const {
+            return std::sqrt(dot(*this));
+        }
+        Vec3 normalized() const {
+            const auto len = length();
+            return len > 0.0f ? *this * (1.0f / len) : *this;
+        }
+        void addAssign(const Vec3& other) {
+            detail::simdAdd4(&x, &other.x, &x);
+        }
+        void subAssign(const Vec3& other) {
+            detail::simdSub4(&x, &other.x, &x);
+        }
+        void mulAssign(const float s) {
+            detail::simdScale4(&x, s, &x);
+        }
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief A four component vector
+     */
+    struct alignas(16) Vec4 {
+        float x{0.0f};
+        float y{0.0f};
+        float z{0.0f};
+        float w{0.0f};
+
+        Vec4() = default;
+        Vec4(const float x, const float y, const float z, const float w) : x(x), y(y), z(z), w(w) {
+        }
+
+        Vec4 operator+(const Vec4& other) const {
+            Vec4 res;
+            detail::simdAdd4(&x, &other.x, &res.x);
+            return res;
+        }
+        Vec4 operator-(const Vec4& other) const {
+            Vec4 res;
+            detail::simdSub4(&x, &other.x, &res.x);
+            return res;
+        }
+        Vec4 operator*(const float s) const {
+            Vec4 res;
+            detail::simdScale4(&x, s, &res.x);
+            return res;
+        }
+        Vec4 operator-() const {
+            return *this * -1.0f;
+        }
+        bool operator==(const Vec4& other) const {
+            return x == other.x && y == other.y && z == other.z && w == other.w;
+        }
+        bool operator!=(const Vec4& other) const {
+            return !(*this == other);
+        }
+        Vec4 mul(const Vec4& other) const {
+            Vec4 res;
+            detail::simdMul4(&x, &other.x, &res.x);
+            return res;
+        }
+        float dot(const Vec4& other) const {
+            return detail::simdDot4(&x, &other.x);
+        }
+        float length() const {
+            return std::sqrt(dot(*this));
+        }
+        Vec4 normalized() const {
+            const auto len = length();
+            return len > 0.0f ? *this * (1.0f / len) : *this;
+        }
+        void addAssign(const Vec4& other) {
+            detail::simdAdd4(&x, &other.x, &x);
+        }
+        void subAssign(const Vec4& other) {
+            detail::simdSub4(&x, &other.x, &x);
+        }
+        void mulAssign(const float s) {
+            detail::simdScale4(&x, s, &x);
+        }
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief A rotation quaternion, the default value is the identity
+     */
+    struct alignas(16) Quat {
+        float x{0.0f};
+        float y{0.0f};
+        float z{0.0f};
+        float w{1.0f};
+
+        Quat() = default;
+        Quat(const float x, const float y, const float z, const float w) : x(x), y(y), z(z), w(w) {
+        }
+
+        /*!
+         * @brief Creates a rotation around an axis, the angle is in radians
+         */
+        static Quat fromAxisAngle(const Vec3& axis, const float angle) {
+            const auto n = axis.normalized();
+            const auto s = std::sin(angle * 0.5f);
+            return Quat(n.x * s, n.y * s, n.z * s, std::cos(angle * 0.5f));
+        }
+
+        Quat operator*(const Quat& o) const {
+            return Quat(w * o.x + x * o.w + y * o.z - z * o.y, w * o.y - x * o.z + y * o.w + z * o.x,
+                        w * o.z + x * o.y - y * o.x + z * o.w, w * o.w - x * o.x - y * o.y - z * o.z);
+        }
+        bool operator==(const Quat& other) const {
+            return x == other.x && y == other.y && z == other.z && w == other.w;
+        }
+        bool operator!=(const Quat& other) const {
+            return !(*this == other);
+        }
+        float dot(const Quat& other) const {
+            return detail::simdDot4(&x, &other.x);
+        }
+        float length() const {
+            return std::sqrt(dot(*this));
+        }
+        Quat normalized() const {
+            const auto len = length();
+            if (len <= 0.0f)
+                return *this;
+            Quat res;
+            detail::simdScale4(&x, 1.0f / len, &res.x);
+            return res;
+        }
+        Quat conjugate() const {
+            return Quat(-x, -y, -z, w);
+        }
+        Vec3 rotate(const Vec3& v) const {
+            // v + 2w(u x v) + 2u x (u x v)
+            const Vec3 u(x, y, z);
+            const auto t = u.cross(v) * 2.0f;
+            return v + t * w + u.cross(t);
+        }
+        void mulAssign(const Quat& other) {
+            *this = *this * other;
+        }
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief A column major 4x4 matrix, the default value is the identity
+     */
+    struct alignas(16) Mat4 {
+        float m[16] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                       0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+
+        Mat4() = default;
+
+        static Mat4 identity() {
+            return Mat4();
+        }
+
+        static Mat4 translation(const Vec3& v) {
+            Mat4 res;
+            res.m[12] = v.x;
+            res.m[13] = v.y;
+            res.m[14] = v.z;
+            return res;
+        }
+
+        static Mat4 scaling(const Vec3& v) {
+            Mat4 res;
+            res.m[0] = v.x;
+            res.m[5] = v.y;
+            res.m[10] = v.z;
+            return res;
+        }
+
+        static Mat4 rotation(const Quat& q) {
+            Mat4 res;
+            const auto xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+            const auto xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+            const auto wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+            res.m[0] = 1.0f - 2.0f * (yy + zz);
+            res.m[1] = 2.0f * (xy + wz);
+            res.m[2] = 2.0f * (xz - wy);
+            res.m[4] = 2.0f * (xy - wz);
+            res.m[5] = 1.0f - 2.0f * (xx + zz);
+            res.m[6] = 2.0f * (yz + wx);
+            res.m[8] = 2.0f * (xz + wy);
+            res.m[9] = 2.0f * (yz - wx);
+            res.m[10] = 1.0f - 2.0f * (xx + yy);
+            return res;
+        }
+
+        Mat4 operator*(const Mat4& other) const {
+            Mat4 res;
+            for (int i = 0; i < 4; i++) {
+                detail::simdTransform4(m, other.m + i * 4, res.m + i * 4);
+            }
+            return res;
+        }
+        bool operator==(const Mat4& other) const {
+            for (int i = 0; i < 16; i++) {
+                if (m[i] != other.m[i])
+                    return false;
+            }
+            return true;
+        }
+        bool operator!=(const Mat4& other) const {
+            return !(*this == other);
+        }
+
+        /*!
+         * @brief Returns an element at column * 4 + row
+         * @throws std::out_of_range if the index is not within the matrix
+         */
+        float get(const size_t index) const {
+            if (index >= 16)
+                throw std::out_of_range("Mat4 index out of range");
+            return m[index];
+        }
+
+        /*!
+         * @brief Replaces an element at column * 4 + row
+         * @throws std::out_of_range if the index is not within the matrix
+         */
+        void set(const size_t index, const float value) {
+            if (index >= 16)
+                throw std::out_of_range("Mat4 index out of range");
+            m[index] = value;
+        }
+
+        Mat4 transposed() const {
+            Mat4 res;
+            for (int c = 0; c < 4; c++) {
+                for (int r = 0; r < 4; r++) {
+                    res.m[r * 4 + c] = m[c * 4 + r];
+                }
+            }
+            return res;
+        }
+
+        Vec4 transform(const Vec4& v) const {
+            Vec4 res;
+            detail::simdTransform4(m, &v.x, &res.x);
+            return res;
+        }
+
+        /*!
+         * @brief Transforms a point (w = 1) without the perspective divide
+         */
+        Vec3 transformPoint(const Vec3& v) const {
+            const float in[4] = {v.x, v.y, v.z, 1.0f};
+            Vec3 res;
+            detail::simdTransform4(m, in, &res.x);
+            res.padding = 0.0f;
+            return res;
+        }
+
+        /*!
+         * @brief Transforms a direction (w = 0), the translation is ignored
+         */
+        Vec3 transformDirection(const Vec3& v) const {
+            const float in[4] = {v.x, v.y, v.z, 0.0f};
+            Vec3 res;
+            detail::simdTransform4(m, in, &res.x);
+            res.padding = 0.0f;
+            return res;
+        }
+
+        /*!
+         * @brief Transforms tightly packed x, y, z points in place
+         * @throws std::invalid_argument if the size is not a multiple of 3
+         */
+        void transformPoints(float* data, const size_t size) const {
+            if (size % 3 != 0)
+                throw std::invalid_argument("Buffer size is not a multiple of 3");
+            float out[4];
+            for (size_t i = 0; i < size; i += 3) {
+                const float in[4] = {data[i], data[i + 1], data[i + 2], 1.0f};
+                detail::simdTransform4(m, in, out);
+                data[i] = out[0];
+                data[i + 1] = out[1];
+                data[i + 2] = out[2];
+            }
+        }
+
+        /*!
+         * @brief Transforms tightly packed x, y, z, w vectors in place
+         * @throws std::invalid_argument if the size is not a multiple of 4
+         */
+        void transformVectors(float* data, const size_t size) const {
+            if (size % 4 != 0)
+                throw std::invalid_argument("Buffer size is not a multiple of 4");
+            for (size_t i = 0; i < size; i += 4) {
+                detail::simdTransform4(m, data + i, data + i);
+            }
+        }
+
+        void mulAssign(const Mat4& other) {
+            *this = *this * other;
+        }
+    };
+
+    template <> struct ForeignInlinePolicy<Vec2> : std::true_type {};
+    template <> struct ForeignInlinePolicy<Vec3> : std::true_type {};
+    template <> struct ForeignInlinePolicy<Vec4> : std::true_type {};
+    template <> struct ForeignInlinePolicy<Quat> : std::true_type {};
+    template <> struct ForeignInlinePolicy<Mat4> : std::true_type {};
+
+    template <typename V> class VectorBindings {
+    public:
+        static V add(V& self, const V& other) {
+            return self + other;
+        }
+
+        static V sub(V& self, const V& other) {
+            return self - other;
+        }
+
+        static V scale(V& self, float s) {
+            return self * s;
+        }
+
+        static V neg(V& self) {
+            return -self;
+        }
+
+        static bool equal(V& self, const V& other) {
+            return self == other;
+        }
+
+        static bool notEqual(V& self, const V& other) {
+            return self != other;
+        }
+
+        static void bind(ForeignKlassImpl<V>& cls) {
+            cls.template funcExt<&VectorBindings<V>::add>(OPERATOR_ADD);
+            cls.template funcExt<&VectorBindings<V>::sub>(OPERATOR_SUB);
+            cls.template funcExt<&VectorBindings<V>::scale>(OPERATOR_MUL);
+            cls.template funcExt<&VectorBindings<V>::neg>(OPERATOR_NEG);
+            cls.template funcExt<&VectorBindings<V>::equal>(OPERATOR_EQUAL);
+            cls.template funcExt<&VectorBindings<V>::notEqual>(OPERATOR_NOT_EQUAL);
+            cls.template func<&V::mul>("mul");
+            cls.template func<&V::dot>("dot");
+            cls.template func<&V::normalized>("normalized");
+            cls.template func<&V::addAssign>("addAssign");
+            cls.template func<&V::subAssign>("subAssign");
+            cls.template func<&V::mulAssign>("mulAssign");
+            cls.template propReadonly<&V::length>("length");
+            cls.template var<&V::x>("x");
+            cls.template var<&V::y>("y");
+        }
+    };
+
+    class MathBindings {
+    public:
+        static Quat mulQuat(Quat& self, const Quat& other) {
+            return self * other;
+        }
+
+        static bool equalQuat(Quat& self, const Quat& other) {
+            return self == other;
+        }
+
+        static Mat4 mulMat4(Mat4& self, const Mat4& other) {
+            return self * other;
+        }
+
+        static bool equalMat4(Mat4& self, const Mat4& other) {
+            return self == other;
+        }
+
+        static void transformPoints(Mat4& self, Float32Array& buffer) {
+            BufferBindings<float>::checkWritable(buffer);
+            self.transformPoints(buffer.data(), buffer.size());
+        }
+
+        static void transformVectors(Mat4& self, Float32Array& buffer) {
+            BufferBindings<float>::checkWritable(buffer);
+            self.transformVectors(buffer.data(), buffer.size());
+        }
+
+        static void bind(ForeignModule& m) {
+            {
+                auto& cls = m.klass<Vec2>("Vec2");
+                cls.ctor<float, float>();
+                VectorBindings<Vec2>::bind(cls);
+            }
+            {
+                auto& cls = m.klass<Vec3>("Vec3");
+                cls.ctor<float, float, float>();
+                VectorBindings<Vec3>::bind(cls);
+                cls.var<&Vec3::z>("z");
+                cls.func<&Vec3::cross>("cross");
+            }
+            {
+                auto& cls = m.klass<Vec4>("Vec4");
+                cls.ctor<float, float, float, float>();
+                VectorBindings<Vec4>::bind(cls);
+                cls.var<&Vec4::z>("z");
+                cls.var<&Vec4::w>("w");
+            }
+            {
+                auto& cls = m.klass<Quat>("Quat");
+                cls.ctor<float, float, float, float>();
+                cls.funcStatic<&Quat::fromAxisAngle>("fromAxisAngle");
+                cls.funcExt<&MathBindings::mulQuat>(OPERATOR_MUL);
+                cls.funcExt<&MathBindings::equalQuat>(OPERATOR_EQUAL);
+                cls.func<&Quat::dot>("dot");
+                cls.func<&Quat::normalized>("normalized");
+                cls.func<&Quat::conjugate>("conjugate");
+                cls.func<&Quat::rotate>("rotate");
+                cls.func<&Quat::mulAssign>("mulAssign");
+                cls.propReadonly<&Quat::length>("length");
+                cls.var<&Quat::x>("x");
+                cls.var<&Quat::y>("y");
+                cls.var<&Quat::z>("z");
+                cls.var<&Quat::w>("w");
+            }
+            {
+                auto& cls = m.klass<Mat4>("Mat4");
+                cls.ctor<>();
+                cls.funcStatic<&Mat4::identity>("identity");
+                cls.funcStatic<&Mat4::translation>("translation");
+                cls.funcStatic<&Mat4::scaling>("scaling");
+                cls.funcStatic<&Mat4::rotation>("rotation");
+                cls.funcExt<&MathBindings::mulMat4>(OPERATOR_MUL);
+                cls.funcExt<&MathBindings::equalMat4>(OPERATOR_EQUAL);
+                cls.func<&Mat4::get>(OPERATOR_GET_INDEX);
+                cls.func<&Mat4::set>(OPERATOR_SET_INDEX);
+                cls.func<&Mat4::transposed>("transposed");
+                cls.func<&Mat4::transform>("transform");
+                cls.func<&Mat4::transformPoint>("transformPoint");
+                cls.func<&Mat4::transformDirection>("transformDirection");
+                cls.func<&Mat4::mulAssign>("mulAssign");
+                cls.funcExt<&MathBindings::transformPoints>("transformPoints");
+                cls.funcExt<&MathBindings::transformVectors>("transformVectors");
+            }
+        }
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Registers Vec2, Vec3, Vec4, Quat, and Mat4 into a module
+     * @details The instances are stored directly in the Wren objects, creating them
+     * from Wren or returning them from C++ does not allocate anything besides the Wren object.
+     * Mat4 transformPoints() and transformVectors() need Float32Array registered
+     * via bindBuffers() in the same module.
+     */
+    inline void bindMath(ForeignModule& m) {
+        MathBindings::bind(m);
+    }
+} // namespace wrenbind17
@@ -32,6 +32,7 @@ namespace wrenbind17 {
 
                 pushArgs(vm, 1, std::forward<Args>(args)...);
 
+                const CallScope scope(vm);
                 if (wrenCall(vm, func) != WREN_RESULT_SUCCESS) {
                     throw RuntimeError(getLastError(vm));
                 }
@@ -44,7 +44,7 @@ namespace wrenbind17 {
         template <typename T, typename... Others>
         ForeignKlassImpl<T>& klass(std::string name) {
             insertKlassCast<T, Others...>();
-            auto ptr = std::make_unique<ForeignKlassImpl<T>>(std::move(name));
+            auto ptr = std::make_unique<ForeignKlassImpl<T>>(std::move(name), vm);
             auto ret = ptr.get();
             addClassType(vm, this->name, ptr->getName(), typeid(T).hash_code());
             klasses.insert(std::make_pair(ptr->getName(), std::move(ptr)));
@@ -73,6 +73,11 @@ namespace wrenbind17 {
             return *it->second;
         }
 
+        ForeignKlass* lookupKlass(const std::string& name) {
+            auto it = klasses.find(name);
+            return it != klasses.end() ? it->second.get() : nullptr;
+        }
+
         const std::string& getName() const {
             return name;
         }
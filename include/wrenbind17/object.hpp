@@ -2,6 +2,7 @@
 
 #include <wren.hpp>
 
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <string>
@@ -17,6 +18,7 @@
 namespace wrenbind17 {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     std::string getLastError(WrenVM* vm);
+    size_t& getCallDepth(WrenVM* vm);
 
     inline void exceptionHandler(WrenVM* vm, const std::exception_ptr& eptr) {
         try {
@@ -38,17 +40,53 @@ namespace wrenbind17 {
     template <class T> struct is_shared_ptr<std::shared_ptr<T>> : std::true_type {};
 
     namespace detail {
+        // Counts the calls into Wren made by this library, foreign functions are called within them
+        class CallScope {
+        public:
+            explicit CallScope(WrenVM* vm) : depth(getCallDepth(vm)) {
+                depth++;
+            }
+
+            ~CallScope() {
+                depth--;
+            }
+
+            CallScope(const CallScope& other) = delete;
+            CallScope& operator=(const CallScope& other) = delete;
+
+        private:
+            size_t& depth;
+        };
+
         class Foreign {
         public:
             Foreign() = default;
             virtual ~Foreign() = 0;
             virtual void* get() const = 0;
             virtual size_t hash() const = 0;
+
+            /*!
+             * @brief Returns true if there is no shared pointer to hand out
+             * @details Either this only references a C++ instance owned by someone else,
+             * or the instance is stored directly in the Wren object.
+             */
+            virtual bool borrowed() const {
+                return false;
+            }
+
+            /*!
+             * @brief Returns false if get() would throw
+             */
+            virtual bool valid() const {
+                return true;
+            }
         };
 
         inline Foreign::~Foreign() {
         }
 
+        class ReleaseQueue;
+
         template <typename T> class ForeignObject : public Foreign {
         public:
             ForeignObject() {
@@ -72,6 +110,70 @@ namespace wrenbind17 {
             }
 
             std::shared_ptr<T> ptr;
+            // The queue of the VM if the class has deferred release enabled
+            ReleaseQueue* releases{nullptr};
+        };
+
+        /*!
+         * @brief A non-owning reference to a C++ instance, used for pointers and references
+         * @details Holds only the raw pointer, so there is no shared pointer control block.
+         */
+        template <typename T> class ForeignBorrowed : public Foreign {
+        public:
+            explicit ForeignBorrowed(T* ptr) : ptr(ptr) {
+            }
+
+            virtual ~ForeignBorrowed() = default;
+
+            void* get() const override {
+                return ptr;
+            }
+
+            size_t hash() const override {
+                return typeid(T).hash_code();
+            }
+
+            bool borrowed() const override {
+                return true;
+            }
+
+            T* ptr;
+        };
+
+        /*!
+         * @brief Holds the C++ instance directly in the Wren object memory
+         * @details Wren does not guarantee more than pointer alignment, the storage
+         * is over-sized so that the instance can be placed at its natural alignment.
+         */
+        template <typename T> class ForeignValue : public Foreign {
+        public:
+            template <typename... Args> explicit ForeignValue(Args&&... args) {
+                new (ptr()) T(std::forward<Args>(args)...);
+            }
+
+            virtual ~ForeignValue() {
+                ptr()->~T();
+            }
+
+            void* get() const override {
+                return ptr();
+            }
+
+            size_t hash() const override {
+                return typeid(T).hash_code();
+            }
+
+            bool borrowed() const override {
+                return true;
+            }
+
+        private:
+            T* ptr() const {
+                const auto addr = reinterpret_cast<uintptr_t>(storage);
+                return reinterpret_cast<T*>((addr + alignof(T) - 1) & ~(uintptr_t(alignof(T)) - 1));
+            }
+
+            mutable unsigned char storage[sizeof(T) + alignof(T) - 1];
         };
 
         class ForeignPtrConvertor {
@@ -86,6 +188,7 @@ namespace wrenbind17 {
             virtual ~ForeignSharedPtrConvertor() = default;
 
             virtual std::shared_ptr<T> cast(Foreign* foreign) const = 0;
+            virtual T* castPtr(Foreign* foreign) const = 0;
         };
 
         template <typename From, typename To>
@@ -97,11 +200,19 @@ namespace wrenbind17 {
             inline std::shared_ptr<To> cast(Foreign* foreign) const override {
                 if (!foreign)
                     throw Exception("Cannot upcast foreign pointer is null and this should not happen");
+                if (foreign->borrowed())
+                    throw BadCast("Bad cast the value is a borrowed reference and cannot be shared");
                 auto* ptr = dynamic_cast<ForeignObject<From>*>(foreign);
                 if (!ptr)
                     throw BadCast("Bad cast while upcasting to a base type");
                 return std::dynamic_pointer_cast<To>(ptr->shared());
             }
+
+            inline To* castPtr(Foreign* foreign) const override {
+                if (!foreign)
+                    throw Exception("Cannot upcast foreign pointer is null and this should not happen");
+                return static_cast<To*>(reinterpret_cast<From*>(foreign->get()));
+            }
         };
 
         template <class T> struct is_shared_ptr : std::false_type {};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief An allocator that keeps freed blocks in a thread local free list
+     * @details Meant for classes that are created and destroyed very often.
+     * Single element allocations are served from a free list owned by the calling thread,
+     * only when the list is empty the global heap is used. Up to MaxFree blocks are kept
+     * per thread, the rest is returned back to the heap. A block freed by another thread
+     * simply ends up in the free list of that thread. Anything else than a single element
+     * is allocated from the global heap.
+     * @see ForeignAllocatorPolicy
+     */
+    template <typename T, size_t MaxFree = 4096> class PoolAllocator {
+    public:
+        typedef T value_type;
+
+        template <typename U> struct rebind {
+            typedef PoolAllocator<U, MaxFree> other;
+        };
+
+        PoolAllocator() noexcept = default;
+
+        template <typename U> PoolAllocator(const PoolAllocator<U, MaxFree>& other) noexcept {
+            (void)other;
+        }
+
+        T* allocate(const size_t n) {
+            if (n == 1) {
+                auto& list = freeList();
+                if (list.head) {
+                    auto* node = list.head;
+                    list.head = node->next;
+                    list.size--;
+                    return reinterpret_cast<T*>(node);
+                }
+            }
+            return static_cast<T*>(allocateRaw(n));
+        }
+
+        void deallocate(T* ptr, const size_t n) noexcept {
+            if (n == 1) {
+                auto& list = freeList();
+                if (list.size < MaxFree) {
+                    auto* node = reinterpret_cast<Node*>(ptr);
+                    node->next = list.head;
+                    list.head = node;
+                    list.size++;
+                    return;
+                }
+            }
+            deallocateRaw(ptr);
+        }
+
+        template <typename U> bool operator==(const PoolAllocator<U, MaxFree>& other) const noexcept {
+            (void)other;
+            return true;
+        }
+
+        template <typename U> bool operator!=(const PoolAllocator<U, MaxFree>& other) const noexcept {
+            (void)other;
+            return false;
+        }
+
+    private:
+        union Node {
+            Node* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        struct FreeList {
+            ~FreeList() {
+                while (head) {
+                    auto* next = head->next;
+                    deallocateRaw(head);
+                    head = next;
+                }
+                // Anything freed after this goes straight to the heap
+                size = MaxFree;
+            }
+
+            Node* head{nullptr};
+            size_t size{0};
+        };
+
+        static FreeList& freeList() {
+            static thread_local FreeList list;
+            return list;
+        }
+
+        // A block must be able to hold the free list pointer too
+        static void* allocateRaw(const size_t n) {
+            const auto bytes = n == 1 ? sizeof(Node) : n * sizeof(T);
+            if constexpr (alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                return ::operator new(bytes, std::align_val_t(alignof(Node)));
+            } else {
+                return ::operator new(bytes);
+            }
+        }
+
+        static void deallocateRaw(void* ptr) noexcept {
+            if constexpr (alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                ::operator delete(ptr, std::align_val_t(alignof(Node)));
+            } else {
+                ::operator delete(ptr);
+            }
+        }
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Selects the allocator of the shared pointers created for foreign objects
+     * @details Specialize this for your class to change where the instances created by
+     * the Wren constructor or copied/moved into Wren are allocated. The allocator is used
+     * via std::allocate_shared, so the instance and the control block are a single allocation.
+     * @code
+     * template <> struct wrenbind17::ForeignAllocatorPolicy<Bullet> {
+     *     typedef wrenbind17::PoolAllocator<Bullet> type;
+     * };
+     * @endcode
+     */
+    template <typename T> struct ForeignAllocatorPolicy {
+        typedef std::allocator<T> type;
+    };
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Selects whether instances of a class are stored directly in the Wren object
+     * @details Specialize this as std::true_type for small value types (vectors, colors, etc.)
+     * Instances created by the Wren constructor, or copied/moved into Wren, are then stored
+     * in the Wren object memory without any heap allocation. Such instances can be popped as
+     * values, pointers, or references, but not as std::shared_ptr.
+     * @code
+     * template <> struct wrenbind17::ForeignInlinePolicy<Color> : std::true_type {};
+     * @endcode
+     */
+    template <typename T> struct ForeignInlinePolicy : std::false_type {};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        template <typename T, typename... Args> inline std::shared_ptr<T> makeForeignShared(Args&&... args) {
+            typedef typename ForeignAllocatorPolicy<T>::type Allocator;
+            return std::allocate_shared<T>(Allocator(), std::forward<Args>(args)...);
+        }
+    } // namespace detail
+#endif
+} // namespace wrenbind17
@@ -2,17 +2,31 @@
 
 #include <wren.hpp>
 
+#include <map>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 #include "object.hpp"
 
 namespace wrenbind17 {
     void getClassType(WrenVM* vm, std::string& module, std::string& name, size_t hash);
     detail::ForeignPtrConvertor* getClassCast(WrenVM* vm, size_t hash, size_t other);
+    void callMapEntries(WrenVM* vm, WrenHandle* map);
+    bool needsIdentity(WrenVM* vm, size_t hash, const void* ptr);
+    void addIdentity(WrenVM* vm, size_t hash, const void* ptr, int idx, std::weak_ptr<const void> owner);
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     namespace detail {
+        // Native Wren maps can not be read through the slots API, they are converted by
+        // MapEntries.of(_) from the "wrenbind17:maps" module first, see stdmap.hpp
+        template <typename T> struct is_native_map : std::false_type {};
+        template <typename K, typename T> struct is_native_map<std::map<K, T>> : std::true_type {};
+        template <typename K, typename T> struct is_native_map<std::unordered_map<K, T>> : std::true_type {};
+
+        // The foreign class marking the list [tag, keys, values] returned by MapEntries.of(_)
+        struct MapEntriesTag {};
+
         // ============================================================================================================
         //                                       CHECK SLOTS FOR TYPE
         // ============================================================================================================
@@ -24,6 +38,8 @@ namespace wrenbind17 {
                     return "instance";
                 case WREN_TYPE_LIST:
                     return "list";
+                case WREN_TYPE_MAP:
+                    return "map";
                 case WREN_TYPE_NULL:
                     return "null";
                 case WREN_TYPE_NUM:
@@ -181,20 +197,59 @@ namespace wrenbind17 {
                 }
             }
 
+            if (foreign->borrowed())
+                throw BadCast("Bad cast the value is a borrowed reference and cannot be shared");
+
             auto ptr = reinterpret_cast<ForeignObject<Type>*>(foreign);
             return ptr->shared();
         }
 
         template <typename T> const std::shared_ptr<T> getSlotForeign(WrenVM* vm, const int idx) {
+            using Type = typename std::remove_const<typename std::remove_pointer<T>::type>::type;
+
+            validate<WrenType::WREN_TYPE_FOREIGN>(vm, idx);
+            const auto slot = wrenGetSlotForeign(vm, idx);
+            auto ptr = getSlotForeign<T>(vm, slot);
+            // C++ can push the instance again, so the identity of its Wren object is kept
+            const auto hash = typeid(Type).hash_code();
+            if (ptr && reinterpret_cast<Foreign*>(slot)->hash() == hash && needsIdentity(vm, hash, ptr.get()))
+                addIdentity(vm, hash, ptr.get(), idx, ptr);
+            return ptr;
+        }
+
+        // Works for both owned and borrowed instances without touching the shared pointer
+        template <typename T> T* getSlotForeignPtr(WrenVM* vm, void* slot) {
+            using Type = typename std::remove_const<typename std::remove_pointer<T>::type>::type;
+            using ForeignTypeConvertor = ForeignSharedPtrConvertor<Type>;
+
+            const auto foreign = reinterpret_cast<Foreign*>(slot);
+            if (foreign->hash() != typeid(Type).hash_code()) {
+                try {
+                    auto base = getClassCast(vm, foreign->hash(), typeid(Type).hash_code());
+                    auto derived = reinterpret_cast<ForeignTypeConvertor*>(base);
+                    if (!derived) {
+                        throw BadCast("Bad cast the value cannot be upcast to the expected type");
+                    }
+                    return derived->castPtr(foreign);
+                } catch (std::out_of_range& e) {
+                    (void)e;
+                    throw BadCast("Bad cast the value is not the expected type");
+                }
+            }
+
+            return reinterpret_cast<Type*>(foreign->get());
+        }
+
+        template <typename T> T* getSlotForeignPtr(WrenVM* vm, const int idx) {
             validate<WrenType::WREN_TYPE_FOREIGN>(vm, idx);
-            return getSlotForeign<T>(vm, wrenGetSlotForeign(vm, idx));
+            return getSlotForeignPtr<T>(vm, wrenGetSlotForeign(vm, idx));
         }
 
         template <typename T> T getSlot(WrenVM* vm, int idx) {
             static_assert(!std::is_same<std::string, T>(), "type can't be std::string");
             static_assert(!is_shared_ptr<T>::value, "type can't be shared_ptr<T>");
             validate<WrenType::WREN_TYPE_FOREIGN>(vm, idx);
-            return *getSlotForeign<typename std::remove_reference<T>::type>(vm, idx).get();
+            return *getSlotForeignPtr<typename std::remove_reference<T>::type>(vm, idx);
         }
 
         template <typename T> struct PopHelper {
@@ -210,7 +265,7 @@ namespace wrenbind17 {
                     return nullptr;
                 else if (type != WrenType::WREN_TYPE_FOREIGN)
                     throw BadCast("Bad cast when getting value from Wren");
-                return getSlotForeign<typename std::remove_const<T>::type>(vm, idx).get();
+                return getSlotForeignPtr<typename std::remove_const<T>::type>(vm, idx);
             }
         };
 
@@ -219,7 +274,7 @@ namespace wrenbind17 {
                 static_assert(!std::is_same<std::string, T>(), "type can't be std::string");
                 static_assert(!std::is_same<std::nullptr_t, T>(), "type can't be std::nullptr_t");
                 static_assert(!is_shared_ptr<T>::value, "type can't be shared_ptr<T>");
-                return *getSlotForeign<T>(vm, idx).get();
+                return *getSlotForeignPtr<T>(vm, idx);
             }
         };
 
@@ -330,6 +385,18 @@ namespace wrenbind17 {
             return static_cast<double>(wrenGetSlotDouble(vm, idx));
         }
 
+        template <typename T> inline void loopAndPopNumbers(WrenVM* vm, const int idx, T* out, const size_t size) {
+            // The element slot is placed past all of the current slots, so popping
+            // a list does not overwrite any other argument of the same call.
+            const auto slot = wrenGetSlotCount(vm);
+            wrenEnsureSlots(vm, slot + 1);
+            for (size_t i = 0; i < size; i++) {
+                wrenGetListElement(vm, idx, static_cast<int>(i), slot);
+                validate<WrenType::WREN_TYPE_NUM>(vm, slot);
+                out[i] = static_cast<T>(wrenGetSlotDouble(vm, slot));
+            }
+        }
+
 #define WRENBIND17_POP_HELPER(Type)                                                                                    \
     template <> struct PopHelper<const Type&> {                                                                        \
         static inline Type f(WrenVM* vm, int idx) {                                                                    \
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "vm.hpp"
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+    /**
+     * @ingroup wrenbind17
+     * @brief Creates an executor that runs the tasks on multiple threads
+     * @details Use it with VM::prefetch() to read the scripts in parallel. This header is not
+     * included by wrenbind17.hpp, so only the applications that include it need to link
+     * the threads library of the platform.
+     * @param threads The maximum number of threads, zero uses the number of hardware threads
+     */
+    inline ExecutorFn threadExecutor(size_t threads = 0) {
+        if (threads == 0)
+            threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+        return [threads](const size_t count, const std::function<void(size_t index)>& task) {
+            // The workers take the next task until all of them are done
+            std::atomic<size_t> next{0};
+            const auto work = [&]() {
+                for (auto i = next++; i < count; i = next++) {
+                    task(i);
+                }
+            };
+
+            std::vector<std::future<void>> workers;
+            for (size_t i = 1; i < std::min(threads, count); i++) {
+                workers.push_back(std::async(std::launch::async, work));
+            }
+            work();
+            for (auto& worker : workers) {
+                worker.get();
+            }
+        };
+    }
+} // namespace wrenbind17
@@ -2,20 +2,37 @@
 
 #include <wren.hpp>
 
+#include <memory>
 #include <string>
 
 #include "exception.hpp"
 #include "object.hpp"
+#include "pool.hpp"
 
 namespace wrenbind17 {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     void getClassType(WrenVM* vm, std::string& module, std::string& name, size_t hash);
     bool isClassRegistered(WrenVM* vm, const size_t hash);
     detail::ForeignPtrConvertor* getClassCast(WrenVM* vm, size_t hash, size_t other);
+    void enableIdentity(WrenVM* vm, size_t hash, size_t limit);
+    WrenHandle* findIdentity(WrenVM* vm, size_t hash, const void* ptr, bool owned);
+    void addIdentity(WrenVM* vm, size_t hash, const void* ptr, int idx, std::weak_ptr<const void> owner);
+    void enableDeferredRelease(WrenVM* vm, size_t hash);
+    detail::ReleaseQueue* getReleaseQueue(WrenVM* vm, size_t hash);
 
     namespace detail {
         template <typename T> struct PushHelper;
 
+        // Pushes the existing Wren object of this pointer, if the class has identity enabled
+        template <typename T> inline bool pushIdentity(WrenVM* vm, const int idx, const T* value, const bool owned) {
+            if (auto* handle = findIdentity(vm, typeid(T).hash_code(), value, owned)) {
+                wrenEnsureSlots(vm, idx + 1);
+                wrenSetSlotHandle(vm, idx, handle);
+                return true;
+            }
+            return false;
+        }
+
         template <typename T> void pushAsConstRef(WrenVM* vm, int idx, const T& value) {
             static_assert(!std::is_same<int, typename std::remove_const<T>::type>(), "type can't be int");
             static_assert(!std::is_same<std::string, typename std::remove_const<T>::type>(),
@@ -29,9 +46,16 @@ namespace wrenbind17 {
                 wrenEnsureSlots(vm, idx + 1);
                 wrenGetVariable(vm, module.c_str(), klass.c_str(), idx);
 
-                auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignObject<T>));
-                auto* foreign = new (memory) ForeignObject<T>(std::make_shared<T>(value));
-                (void)foreign;
+                if constexpr (ForeignInlinePolicy<T>::value) {
+                    static_assert(std::is_nothrow_copy_constructible<T>::value,
+                                  "inline type must be nothrow copy constructible");
+                    auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignValue<T>));
+                    new (memory) ForeignValue<T>(value);
+                } else {
+                    auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignObject<T>));
+                    auto* foreign = new (memory) ForeignObject<T>(makeForeignShared<T>(value));
+                    foreign->releases = getReleaseQueue(vm, typeid(T).hash_code());
+                }
             } catch (std::out_of_range& e) {
                 (void)e;
                 throw BadCast("Class type not registered in Wren VM");
@@ -50,9 +74,16 @@ namespace wrenbind17 {
                 wrenEnsureSlots(vm, idx + 1);
                 wrenGetVariable(vm, module.c_str(), klass.c_str(), idx);
 
-                auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignObject<T>));
-                auto* foreign = new (memory) ForeignObject<T>(std::make_shared<T>(std::move(value)));
-                (void)foreign;
+                if constexpr (ForeignInlinePolicy<T>::value) {
+                    static_assert(std::is_nothrow_move_constructible<T>::value,
+                                  "inline type must be nothrow move constructible");
+                    auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignValue<T>));
+                    new (memory) ForeignValue<T>(std::move(value));
+                } else {
+                    auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignObject<T>));
+                    auto* foreign = new (memory) ForeignObject<T>(makeForeignShared<T>(std::move(value)));
+                    foreign->releases = getReleaseQueue(vm, typeid(T).hash_code());
+                }
             } catch (std::out_of_range& e) {
                 (void)e;
                 throw BadCast("Class type not registered in Wren VM");
@@ -63,6 +94,8 @@ namespace wrenbind17 {
             static_assert(!std::is_same<int, T>(), "type can't be int");
             static_assert(!std::is_same<std::string, T>(), "type can't be std::string");
             static_assert(!is_shared_ptr<T>::value, "type can't be shared_ptr<T>");
+            if (pushIdentity<T>(vm, idx, value, false))
+                return;
             try {
                 std::string module;
                 std::string klass;
@@ -71,9 +104,10 @@ namespace wrenbind17 {
                 wrenEnsureSlots(vm, idx + 1);
                 wrenGetVariable(vm, module.c_str(), klass.c_str(), idx);
 
-                auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignObject<T>));
-                auto* foreign = new (memory) ForeignObject<T>(std::shared_ptr<T>(value, [](T* t) {}));
+                auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignBorrowed<T>));
+                auto* foreign = new (memory) ForeignBorrowed<T>(value);
                 (void)foreign;
+                addIdentity(vm, typeid(T).hash_code(), value, idx, {});
             } catch (std::out_of_range& e) {
                 (void)e;
                 throw BadCast("Class type not registered in Wren VM");
@@ -233,6 +267,8 @@ namespace wrenbind17 {
             static inline void f(WrenVM* vm, int idx, std::shared_ptr<T> value) {
                 static_assert(!std::is_same<std::string, T>(), "type can't be std::string");
                 static_assert(!is_shared_ptr<T>::value, "type can't be shared_ptr<T>");
+                if (value && pushIdentity<T>(vm, idx, value.get(), true))
+                    return;
                 try {
                     std::string module;
                     std::string klass;
@@ -243,7 +279,9 @@ namespace wrenbind17 {
 
                     auto memory = wrenSetSlotNewForeign(vm, idx, idx, sizeof(ForeignObject<T>));
                     auto* foreign = new (memory) ForeignObject<T>(value);
-                    (void)foreign;
+                    foreign->releases = getReleaseQueue(vm, typeid(T).hash_code());
+                    if (value)
+                        addIdentity(vm, typeid(T).hash_code(), value.get(), idx, value);
                 } catch (std::out_of_range& e) {
                     (void)e;
                     throw BadCast("Class type not registered in Wren VM");
@@ -275,22 +313,43 @@ namespace wrenbind17 {
             }
         };
 
-        template <typename Iter> inline void loopAndPushIterable(WrenVM* vm, const int idx, Iter begin, Iter end) {
-            using T = typename std::iterator_traits<Iter>::value_type;
+        template <typename T>
+        struct is_list_number
+            : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+
+        template <typename Iter> inline void loopAndPushNumbers(WrenVM* vm, const int idx, Iter begin, Iter end) {
+            // Numbers do not need to go through the PushHelper, so the element
+            // slot is reserved once and every element is converted in place.
+            wrenEnsureSlots(vm, idx + 2);
             wrenSetSlotNewList(vm, idx);
             auto i = 0;
             for (auto it = begin; it != end; ++it) {
-                PushHelper<T>::f(vm, idx + 1, *it);
+                wrenSetSlotDouble(vm, idx + 1, static_cast<double>(*it));
                 wrenInsertInList(vm, idx, i++, idx + 1);
             }
         }
 
+        template <typename Iter> inline void loopAndPushIterable(WrenVM* vm, const int idx, Iter begin, Iter end) {
+            using T = typename std::iterator_traits<Iter>::value_type;
+            if constexpr (is_list_number<T>::value) {
+                loopAndPushNumbers(vm, idx, begin, end);
+            } else {
+                wrenEnsureSlots(vm, idx + 2);
+                wrenSetSlotNewList(vm, idx);
+                auto i = 0;
+                for (auto it = begin; it != end; ++it) {
+                    PushHelper<T>::f(vm, idx + 1, *it);
+                    wrenInsertInList(vm, idx, i++, idx + 1);
+                }
+            }
+        }
+
         template <typename Iter> inline void loopAndPushKeyPair(WrenVM* vm, const int idx, Iter begin, Iter end) {
             using T = typename std::iterator_traits<Iter>::value_type;
             using Key = typename T::first_type;
             using Value = typename T::second_type;
+            wrenEnsureSlots(vm, idx + 3);
             wrenSetSlotNewMap(vm, idx);
-            wrenEnsureSlots(vm, 3);
             for (auto it = begin; it != end; ++it) {
                 PushHelper<Key>::f(vm, idx + 1, std::forward<Key>(it->first));
                 PushHelper<Value>::f(vm, idx + 2, std::forward<Value>(it->second));
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @ingroup wrenbind17
+ */
+namespace wrenbind17 {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        constexpr size_t countDigits(size_t n) {
+            size_t res = 1;
+            while (n >= 10) {
+                n /= 10;
+                res++;
+            }
+            return res;
+        }
+
+        // Length of "(_,_,_)" plus the null terminator
+        constexpr size_t signatureNamesSize(const size_t n) {
+            return n == 0 ? 3 : 2 * n + 2;
+        }
+
+        // Length of "(arg0, arg1, arg2)" plus the null terminator
+        constexpr size_t signatureParamsSize(const size_t n) {
+            size_t res = 3;
+            for (size_t i = 0; i < n; i++) {
+                res += 3 + countDigits(i) + (i == 0 ? 0 : 2);
+            }
+            return res;
+        }
+
+        template <size_t N> constexpr std::array<char, signatureNamesSize(N)> makeSignatureNames() {
+            std::array<char, signatureNamesSize(N)> res{};
+            size_t pos = 0;
+            res[pos++] = '(';
+            for (size_t i = 0; i < N; i++) {
+                if (i != 0)
+                    res[pos++] = ',';
+                res[pos++] = '_';
+            }
+            res[pos++] = ')';
+            res[pos] = '\0';
+            return res;
+        }
+
+        template <size_t N> constexpr std::array<char, signatureParamsSize(N)> makeSignatureParams() {
+            std::array<char, signatureParamsSize(N)> res{};
+            size_t pos = 0;
+            res[pos++] = '(';
+            for (size_t i = 0; i < N; i++) {
+                if (i != 0) {
+                    res[pos++] = ',';
+                    res[pos++] = ' ';
+                }
+                res[pos++] = 'a';
+                res[pos++] = 'r';
+                res[pos++] = 'g';
+                const auto digits = countDigits(i);
+                size_t n = i;
+                for (size_t d = 0; d < digits; d++) {
+                    res[pos + digits - d - 1] = static_cast<char>('0' + n % 10);
+                    n /= 10;
+                }
+                pos += digits;
+            }
+            res[pos++] = ')';
+            res[pos] = '\0';
+            return res;
+        }
+
+        // Wren strings that only depend on the number of arguments, built at compile time
+        template <size_t N> struct SignatureText {
+            // The argument part of a Wren signature, for example "(_,_)"
+            static constexpr auto names = makeSignatureNames<N>();
+
+            // The parameter list used in the generated Wren code, for example "(arg0, arg1)"
+            static constexpr auto params = makeSignatureParams<N>();
+        };
+    } // namespace detail
+#endif
+} // namespace wrenbind17
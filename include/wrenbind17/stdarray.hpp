@@ -0,0 +1,77 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <array>
+
+#include "pop.hpp"
+#include "push.hpp"
+
+namespace wrenbind17 {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        template <typename T, size_t N> struct PushHelper<std::array<T, N>> {
+            static inline void f(WrenVM* vm, int idx, std::array<T, N> value) {
+                if (isClassRegistered(vm, typeid(std::array<T, N>).hash_code())) {
+                    pushAsMove<std::array<T, N>>(vm, idx, std::move(value));
+                } else {
+                    loopAndPushIterable(vm, idx, value.begin(), value.end());
+                }
+            }
+        };
+
+        template <typename T, size_t N> struct PushHelper<std::array<T, N>*> {
+            static inline void f(WrenVM* vm, int idx, std::array<T, N>* value) {
+                if (isClassRegistered(vm, typeid(std::array<T, N>).hash_code())) {
+                    pushAsPtr<std::array<T, N>>(vm, idx, value);
+                } else {
+                    loopAndPushIterable(vm, idx, value->begin(), value->end());
+                }
+            }
+        };
+
+        template <typename T, size_t N> struct PushHelper<const std::array<T, N>&> {
+            static inline void f(WrenVM* vm, int idx, const std::array<T, N>& value) {
+                if (isClassRegistered(vm, typeid(std::array<T, N>).hash_code())) {
+                    pushAsConstRef<std::array<T, N>>(vm, idx, value);
+                } else {
+                    loopAndPushIterable(vm, idx, value.begin(), value.end());
+                }
+            }
+        };
+
+        template <typename T, size_t N> struct PopHelper<const std::array<T, N>&> {
+            static inline std::array<T, N> f(WrenVM* vm, const int idx) {
+                const auto type = wrenGetSlotType(vm, idx);
+                if (type == WrenType::WREN_TYPE_FOREIGN) {
+                    return *getSlotForeignPtr<std::array<T, N>>(vm, idx);
+                }
+                if (type != WrenType::WREN_TYPE_LIST)
+                    throw BadCast("Bad cast when getting value from Wren expected list");
+                if (static_cast<size_t>(wrenGetListCount(vm, idx)) != N)
+                    throw BadCast("Bad cast when getting value from Wren expected list of size " + std::to_string(N));
+
+                // Filled in place, no intermediate container
+                std::array<T, N> res{};
+                if constexpr (is_list_number<T>::value) {
+                    loopAndPopNumbers(vm, idx, res.data(), N);
+                } else {
+                    const auto slot = wrenGetSlotCount(vm);
+                    wrenEnsureSlots(vm, slot + 1);
+                    for (size_t i = 0; i < N; i++) {
+                        wrenGetListElement(vm, idx, static_cast<int>(i), slot);
+                        res[i] = PopHelper<T>::f(vm, slot);
+                    }
+                }
+                return res;
+            }
+        };
+
+        template <typename T, size_t N> struct PopHelper<std::array<T, N>> {
+            static inline std::array<T, N> f(WrenVM* vm, const int idx) {
+                return PopHelper<const std::array<T, N>&>::f(vm, idx);
+            }
+        };
+    } // namespace detail
+#endif
+} // namespace wrenbind17
@@ -44,7 +44,7 @@ namespace wrenbind17 {
             static inline std::deque<T> f(WrenVM* vm, const int idx) {
                 const auto type = wrenGetSlotType(vm, idx);
                 if (type == WrenType::WREN_TYPE_FOREIGN) {
-                    return *getSlotForeign<std::deque<T>>(vm, idx).get();
+                    return *getSlotForeignPtr<std::deque<T>>(vm, idx);
                 }
                 if (type != WrenType::WREN_TYPE_LIST)
                     throw BadCast("Bad cast when getting value from Wren expected list");
@@ -11,65 +11,148 @@
 namespace wrenbind17 {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     namespace detail {
-        template <typename T> struct PushHelper<std::map<std::string, T>> {
-            static inline void f(WrenVM* vm, int idx, std::map<std::string, T> value) {
-                if (isClassRegistered(vm, typeid(std::map<std::string, T>).hash_code())) {
-                    pushAsMove<std::map<std::string, T>>(vm, idx, std::move(value));
+        template <typename Map> inline void reserveMap(Map& map, const size_t size) {
+            (void)map;
+            (void)size;
+        }
+
+        template <typename K, typename T> inline void reserveMap(std::unordered_map<K, T>& map, const size_t size) {
+            map.reserve(size);
+        }
+
+        inline bool isMapEntriesTag(WrenVM* vm, const int idx) {
+            if (wrenGetSlotType(vm, idx) != WrenType::WREN_TYPE_FOREIGN)
+                return false;
+            const auto foreign = reinterpret_cast<Foreign*>(wrenGetSlotForeign(vm, idx));
+            return foreign->hash() == typeid(MapEntriesTag).hash_code();
+        }
+
+        // Accepts a foreign instance of the map, or a native Wren map converted by MapEntries.of(_)
+        // from the "wrenbind17:maps" module into a tagged list [tag, keys, values]
+        template <typename Map> inline Map loopAndPopKeyPair(WrenVM* vm, const int idx) {
+            using K = typename Map::key_type;
+            using T = typename Map::mapped_type;
+
+            const auto type = wrenGetSlotType(vm, idx);
+            if (type == WrenType::WREN_TYPE_FOREIGN) {
+                return *getSlotForeignPtr<Map>(vm, idx);
+            }
+            if (type == WrenType::WREN_TYPE_MAP)
+                throw BadCast("Bad cast native Wren maps must be passed as MapEntries.of(map) "
+                              "from the \"wrenbind17:maps\" module");
+            if (type != WrenType::WREN_TYPE_LIST || wrenGetListCount(vm, idx) != 3)
+                throw BadCast("Bad cast when getting value from Wren expected map");
+
+            // The tag, the lists, the key, and the value go into scratch slots past all current slots
+            const auto slot = wrenGetSlotCount(vm);
+            wrenEnsureSlots(vm, slot + 4);
+            wrenGetListElement(vm, idx, 0, slot);
+            if (!isMapEntriesTag(vm, slot))
+                throw BadCast("Bad cast when getting value from Wren expected map");
+            wrenGetListElement(vm, idx, 1, slot);
+            wrenGetListElement(vm, idx, 2, slot + 1);
+            if (wrenGetSlotType(vm, slot) != WrenType::WREN_TYPE_LIST ||
+                wrenGetSlotType(vm, slot + 1) != WrenType::WREN_TYPE_LIST)
+                throw BadCast("Bad cast when getting value from Wren expected map");
+
+            const auto count = wrenGetListCount(vm, slot);
+            if (wrenGetListCount(vm, slot + 1) != count)
+                throw BadCast("Bad cast when getting value from Wren expected map");
+
+            Map res;
+            reserveMap(res, static_cast<size_t>(count));
+            for (auto i = 0; i < count; i++) {
+                wrenGetListElement(vm, slot, i, slot + 2);
+                wrenGetListElement(vm, slot + 1, i, slot + 3);
+                auto key = PopHelper<K>::f(vm, slot + 2);
+                res.emplace(std::move(key), PopHelper<T>::f(vm, slot + 3));
+            }
+            return res;
+        }
+
+        template <typename K, typename T> struct PushHelper<std::map<K, T>> {
+            static inline void f(WrenVM* vm, int idx, std::map<K, T> value) {
+                if (isClassRegistered(vm, typeid(std::map<K, T>).hash_code())) {
+                    pushAsMove<std::map<K, T>>(vm, idx, std::move(value));
                 } else {
                     loopAndPushKeyPair(vm, idx, value.begin(), value.end());
                 }
             }
         };
 
-        template <typename T> struct PushHelper<std::map<std::string, T>*> {
-            static inline void f(WrenVM* vm, int idx, std::map<std::string, T>* value) {
-                if (isClassRegistered(vm, typeid(std::map<std::string, T>).hash_code())) {
-                    pushAsPtr<std::map<std::string, T>>(vm, idx, value);
+        template <typename K, typename T> struct PushHelper<std::map<K, T>*> {
+            static inline void f(WrenVM* vm, int idx, std::map<K, T>* value) {
+                if (isClassRegistered(vm, typeid(std::map<K, T>).hash_code())) {
+                    pushAsPtr<std::map<K, T>>(vm, idx, value);
                 } else {
                     loopAndPushKeyPair(vm, idx, value->begin(), value->end());
                 }
             }
         };
 
-        template <typename T> struct PushHelper<const std::map<std::string, T>&> {
-            static inline void f(WrenVM* vm, int idx, const std::map<std::string, T>& value) {
-                if (isClassRegistered(vm, typeid(std::map<std::string, T>).hash_code())) {
-                    pushAsConstRef<std::map<std::string, T>>(vm, idx, value);
+        template <typename K, typename T> struct PushHelper<const std::map<K, T>&> {
+            static inline void f(WrenVM* vm, int idx, const std::map<K, T>& value) {
+                if (isClassRegistered(vm, typeid(std::map<K, T>).hash_code())) {
+                    pushAsConstRef<std::map<K, T>>(vm, idx, value);
                 } else {
                     loopAndPushKeyPair(vm, idx, value.begin(), value.end());
                 }
             }
         };
 
-        template <typename T> struct PushHelper<std::unordered_map<std::string, T>> {
-            static inline void f(WrenVM* vm, int idx, std::unordered_map<std::string, T> value) {
-                if (isClassRegistered(vm, typeid(std::unordered_map<std::string, T>).hash_code())) {
-                    pushAsMove<std::unordered_map<std::string, T>>(vm, idx, std::move(value));
+        template <typename K, typename T> struct PopHelper<const std::map<K, T>&> {
+            static inline std::map<K, T> f(WrenVM* vm, const int idx) {
+                return loopAndPopKeyPair<std::map<K, T>>(vm, idx);
+            }
+        };
+
+        template <typename K, typename T> struct PopHelper<std::map<K, T>> {
+            static inline std::map<K, T> f(WrenVM* vm, const int idx) {
+                return loopAndPopKeyPair<std::map<K, T>>(vm, idx);
+            }
+        };
+
+        template <typename K, typename T> struct PushHelper<std::unordered_map<K, T>> {
+            static inline void f(WrenVM* vm, int idx, std::unordered_map<K, T> value) {
+                if (isClassRegistered(vm, typeid(std::unordered_map<K, T>).hash_code())) {
+                    pushAsMove<std::unordered_map<K, T>>(vm, idx, std::move(value));
                 } else {
                     loopAndPushKeyPair(vm, idx, value.begin(), value.end());
                 }
             }
         };
 
-        template <typename T> struct PushHelper<std::unordered_map<std::string, T>*> {
-            static inline void f(WrenVM* vm, int idx, std::unordered_map<std::string, T>* value) {
-                if (isClassRegistered(vm, typeid(std::unordered_map<std::string, T>).hash_code())) {
-                    pushAsPtr<std::unordered_map<std::string, T>>(vm, idx, value);
+        template <typename K, typename T> struct PushHelper<std::unordered_map<K, T>*> {
+            static inline void f(WrenVM* vm, int idx, std::unordered_map<K, T>* value) {
+                if (isClassRegistered(vm, typeid(std::unordered_map<K, T>).hash_code())) {
+                    pushAsPtr<std::unordered_map<K, T>>(vm, idx, value);
                 } else {
                     loopAndPushKeyPair(vm, idx, value->begin(), value->end());
                 }
             }
         };
 
-        template <typename T> struct PushHelper<const std::unordered_map<std::string, T>&> {
-            static inline void f(WrenVM* vm, int idx, const std::unordered_map<std::string, T>& value) {
-                if (isClassRegistered(vm, typeid(std::unordered_map<std::string, T>).hash_code())) {
-                    pushAsConstRef<std::unordered_map<std::string, T>>(vm, idx, value);
+        template <typename K, typename T> struct PushHelper<const std::unordered_map<K, T>&> {
+            static inline void f(WrenVM* vm, int idx, const std::unordered_map<K, T>& value) {
+                if (isClassRegistered(vm, typeid(std::unordered_map<K, T>).hash_code())) {
+                    pushAsConstRef<std::unordered_map<K, T>>(vm, idx, value);
                 } else {
                     loopAndPushKeyPair(vm, idx, value.begin(), value.end());
                 }
             }
         };
+
+        template <typename K, typename T> struct PopHelper<const std::unordered_map<K, T>&> {
+            static inline std::unordered_map<K, T> f(WrenVM* vm, const int idx) {
+                return loopAndPopKeyPair<std::unordered_map<K, T>>(vm, idx);
+            }
+        };
+
+        template <typename K, typename T> struct PopHelper<std::unordered_map<K, T>> {
+            static inline std::unordered_map<K, T> f(WrenVM* vm, const int idx) {
+                return loopAndPopKeyPair<std::unordered_map<K, T>>(vm, idx);
+            }
+        };
     } // namespace detail
 #endif
 } // namespace wrenbind17
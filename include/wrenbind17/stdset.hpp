@@ -45,7 +45,7 @@ namespace wrenbind17 {
             static inline std::set<T> f(WrenVM* vm, const int idx) {
                 const auto type = wrenGetSlotType(vm, idx);
                 if (type == WrenType::WREN_TYPE_FOREIGN) {
-                    return *getSlotForeign<std::set<T>>(vm, idx).get();
+                    return *getSlotForeignPtr<std::set<T>>(vm, idx);
                 }
                 if (type != WrenType::WREN_TYPE_LIST)
                     throw BadCast("Bad cast when getting value from Wren expected list");
@@ -102,7 +102,7 @@ namespace wrenbind17 {
             static inline std::set<T> f(WrenVM* vm, const int idx) {
                 const auto type = wrenGetSlotType(vm, idx);
                 if (type == WrenType::WREN_TYPE_FOREIGN) {
-                    return *getSlotForeign<std::unordered_set<T>>(vm, idx).get();
+                    return *getSlotForeignPtr<std::unordered_set<T>>(vm, idx);
                 }
                 if (type != WrenType::WREN_TYPE_LIST)
                     throw BadCast("Bad cast when getting value from Wren expected list");
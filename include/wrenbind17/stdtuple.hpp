@@ -0,0 +1,106 @@
+#pragma once
+
+#include <wren.hpp>
+
+#include <tuple>
+#include <utility>
+
+#include "pop.hpp"
+#include "push.hpp"
+
+namespace wrenbind17 {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    namespace detail {
+        template <typename Tuple, size_t... Is>
+        inline void pushTupleElements(WrenVM* vm, const int idx, const Tuple& value, std::index_sequence<Is...>) {
+            wrenEnsureSlots(vm, idx + 2);
+            wrenSetSlotNewList(vm, idx);
+            ((PushHelper<typename std::remove_const<typename std::tuple_element<Is, Tuple>::type>::type>::f(
+                  vm, idx + 1, std::get<Is>(value)),
+              wrenInsertInList(vm, idx, static_cast<int>(Is), idx + 1)),
+             ...);
+        }
+
+        template <typename T>
+        inline T popTupleElement(WrenVM* vm, const int idx, const int slot, const size_t i) {
+            wrenGetListElement(vm, idx, static_cast<int>(i), slot);
+            return PopHelper<typename std::remove_const<T>::type>::f(vm, slot);
+        }
+
+        template <typename Tuple, size_t... Is>
+        inline Tuple popTupleElements(WrenVM* vm, const int idx, std::index_sequence<Is...>) {
+            const auto type = wrenGetSlotType(vm, idx);
+            if (type != WrenType::WREN_TYPE_LIST)
+                throw BadCast("Bad cast when getting value from Wren expected list");
+            if (static_cast<size_t>(wrenGetListCount(vm, idx)) != sizeof...(Is))
+                throw BadCast("Bad cast when getting value from Wren expected list of size " +
+                              std::to_string(sizeof...(Is)));
+
+            const auto slot = wrenGetSlotCount(vm);
+            wrenEnsureSlots(vm, slot + 1);
+            return Tuple{popTupleElement<typename std::tuple_element<Is, Tuple>::type>(vm, idx, slot, Is)...};
+        }
+
+        template <typename... Ts> struct PushHelper<std::tuple<Ts...>> {
+            static inline void f(WrenVM* vm, int idx, const std::tuple<Ts...>& value) {
+                pushTupleElements(vm, idx, value, std::index_sequence_for<Ts...>{});
+            }
+        };
+
+        template <typename... Ts> struct PushHelper<const std::tuple<Ts...>&> {
+            static inline void f(WrenVM* vm, int idx, const std::tuple<Ts...>& value) {
+                pushTupleElements(vm, idx, value, std::index_sequence_for<Ts...>{});
+            }
+        };
+
+        template <typename... Ts> struct PopHelper<std::tuple<Ts...>> {
+            static inline std::tuple<Ts...> f(WrenVM* vm, const int idx) {
+                return popTupleElements<std::tuple<Ts...>>(vm, idx, std::index_sequence_for<Ts...>{});
+            }
+        };
+
+        template <typename... Ts> struct PopHelper<const std::tuple<Ts...>&> {
+            static inline std::tuple<Ts...> f(WrenVM* vm, const int idx) {
+                return PopHelper<std::tuple<Ts...>>::f(vm, idx);
+            }
+        };
+
+        // Pairs of std::map iterators are registered as foreign classes by the map bindings,
+        // those have to stay as foreign objects.
+        template <typename A, typename B> struct PushHelper<std::pair<A, B>> {
+            static inline void f(WrenVM* vm, int idx, std::pair<A, B> value) {
+                if (isClassRegistered(vm, typeid(std::pair<A, B>).hash_code())) {
+                    pushAsMove<std::pair<A, B>>(vm, idx, std::move(value));
+                } else {
+                    pushTupleElements(vm, idx, value, std::make_index_sequence<2>{});
+                }
+            }
+        };
+
+        template <typename A, typename B> struct PushHelper<const std::pair<A, B>&> {
+            static inline void f(WrenVM* vm, int idx, const std::pair<A, B>& value) {
+                if (isClassRegistered(vm, typeid(std::pair<A, B>).hash_code())) {
+                    pushAsConstRef<std::pair<A, B>>(vm, idx, value);
+                } else {
+                    pushTupleElements(vm, idx, value, std::make_index_sequence<2>{});
+                }
+            }
+        };
+
+        template <typename A, typename B> struct PopHelper<std::pair<A, B>> {
+            static inline std::pair<A, B> f(WrenVM* vm, const int idx) {
+                if (wrenGetSlotType(vm, idx) == WrenType::WREN_TYPE_FOREIGN) {
+                    return *getSlotForeignPtr<std::pair<A, B>>(vm, idx);
+                }
+                return popTupleElements<std::pair<A, B>>(vm, idx, std::make_index_sequence<2>{});
+            }
+        };
+
+        template <typename A, typename B> struct PopHelper<const std::pair<A, B>&> {
+            static inline std::pair<A, B> f(WrenVM* vm, const int idx) {
+                return PopHelper<std::pair<A, B>>::f(vm, idx);
+            }
+        };
+    } // namespace detail
+#endif
+} // namespace wrenbind17
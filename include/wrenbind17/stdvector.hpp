@@ -44,18 +44,26 @@ namespace wrenbind17 {
             static inline std::vector<T> f(WrenVM* vm, const int idx) {
                 const auto type = wrenGetSlotType(vm, idx);
                 if (type == WrenType::WREN_TYPE_FOREIGN) {
-                    return *getSlotForeign<std::vector<T>>(vm, idx).get();
+                    return *getSlotForeignPtr<std::vector<T>>(vm, idx);
                 }
                 if (type != WrenType::WREN_TYPE_LIST)
                     throw BadCast("Bad cast when getting value from Wren expected list");
 
+                const auto size = static_cast<size_t>(wrenGetListCount(vm, idx));
+                if constexpr (is_list_number<T>::value) {
+                    std::vector<T> res(size);
+                    loopAndPopNumbers(vm, idx, res.data(), size);
+                    return res;
+                }
+
+                // The element slot is placed past all of the current slots, same as for numbers
                 std::vector<T> res;
-                const auto size = wrenGetListCount(vm, idx);
-                wrenEnsureSlots(vm, 1);
+                const auto slot = wrenGetSlotCount(vm);
+                wrenEnsureSlots(vm, slot + 1);
                 res.reserve(size);
                 for (size_t i = 0; i < size; i++) {
-                    wrenGetListElement(vm, idx, static_cast<int>(i), idx + 1);
-                    res.push_back(PopHelper<T>::f(vm, idx + 1));
+                    wrenGetListElement(vm, idx, static_cast<int>(i), slot);
+                    res.push_back(PopHelper<T>::f(vm, slot));
                 }
                 return res;
             }
@@ -4,16 +4,42 @@
 
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <functional>
+#include <list>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define WRENBIND17_HAS_MMAP
+#endif
+
+/**
+ * @ingroup wrenbind17
+ * @brief Source files of at least this many bytes are mapped into memory instead of being read
+ */
+#ifndef WRENBIND17_MMAP_THRESHOLD
+#define WRENBIND17_MMAP_THRESHOLD (256 * 1024)
+#endif
+
 #include "exception.hpp"
+#include "list.hpp"
 #include "map.hpp"
 #include "module.hpp"
 #include "variable.hpp"
@@ -35,27 +61,188 @@ namespace std {
 namespace wrenbind17 {
 
     namespace detail {
-        inline std::string defaultLoadFileFn(const std::string& name) {
+        struct FileStat {
+            size_t size{0};
+            int64_t mtime{0};
+
+            bool operator==(const FileStat& other) const {
+                return size == other.size && mtime == other.mtime;
+            }
+        };
+
+        // Returns false if the path does not exist or is not a regular file
+        inline bool statFile(const std::string& path, FileStat& out) {
+            struct stat st {};
+            if (::stat(path.c_str(), &st) != 0 || (st.st_mode & S_IFMT) != S_IFREG)
+                return false;
+            out.size = static_cast<size_t>(st.st_size);
+            out.mtime = static_cast<int64_t>(st.st_mtime);
+            return true;
+        }
+
+        typedef std::unique_ptr<std::FILE, int (*)(std::FILE*)> FilePtr;
+
+        inline FilePtr openFile(const std::string& path, size_t& size) {
+            FileStat st;
+            if (!statFile(path, st))
+                return FilePtr(nullptr, &std::fclose);
+            size = st.size;
+            return FilePtr(std::fopen(path.c_str(), "rb"), &std::fclose);
+        }
+
+        // Reads the whole file with a single read into a null terminated buffer sized up front,
+        // returns nullptr if the file can not be opened
+        inline std::unique_ptr<char[]> readFileBuffer(const std::string& path) {
+            size_t size = 0;
+            auto file = openFile(path, size);
+            if (!file)
+                return nullptr;
+            std::unique_ptr<char[]> buffer(new char[size + 1]);
+            size = std::fread(buffer.get(), 1, size, file.get());
+            buffer[size] = '\0';
+            return buffer;
+        }
+
+        /*
+         * Null terminated contents of a file. Files of at least WRENBIND17_MMAP_THRESHOLD
+         * bytes are mapped into memory, smaller files are read into a heap buffer.
+         */
+        class FileSource {
+        public:
+            explicit FileSource(const std::string& path) {
+#ifdef WRENBIND17_HAS_MMAP
+                FileStat st;
+                if (statFile(path, st) && st.size >= WRENBIND17_MMAP_THRESHOLD) {
+                    data = map(path, st.size, mapped);
+                    if (data)
+                        return;
+                }
+#endif
+                data = readFileBuffer(path).release();
+            }
+
+            ~FileSource() {
+                free(data, mapped);
+            }
+
+            // Takes the ownership of a null terminated heap buffer
+            explicit FileSource(std::unique_ptr<char[]> buffer) : data(buffer.release()) {
+            }
+
+            FileSource() = default;
+
+            FileSource(const FileSource& other) = delete;
+            FileSource(FileSource&& other) noexcept {
+                std::swap(data, other.data);
+                std::swap(mapped, other.mapped);
+            }
+
+            FileSource& operator=(const FileSource& other) = delete;
+            FileSource& operator=(FileSource&& other) noexcept {
+                if (this != &other) {
+                    std::swap(data, other.data);
+                    std::swap(mapped, other.mapped);
+                }
+                return *this;
+            }
 
-            if (auto t = std::ifstream(name)) {
-                std::string source((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
-                return source;
+            const char* get() const {
+                return data;
             }
 
-            throw NotFound();
+            // Gives up the ownership, the memory must be freed via FileSource::free()
+            const char* release(size_t& length) {
+                const auto ret = data;
+                length = mapped;
+                data = nullptr;
+                mapped = 0;
+                return ret;
+            }
+
+            // The length is zero for sources that were not mapped
+            static void free(const char* data, const size_t length) {
+#ifdef WRENBIND17_HAS_MMAP
+                if (length) {
+                    ::munmap(const_cast<char*>(data), length);
+                    return;
+                }
+#endif
+                (void)length;
+                delete[] data;
+            }
+
+        private:
+#ifdef WRENBIND17_HAS_MMAP
+            static const char* map(const std::string& path, const size_t size, size_t& length) {
+                const auto fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    return nullptr;
+
+                // The file is mapped over an anonymous region which is at least one byte longer.
+                // The bytes past the end of the file are zeros, that is the null terminator.
+                const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+                length = (size + page) / page * page;
+                auto base = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0);
+                if (base != MAP_FAILED &&
+                    ::mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                    ::munmap(base, length);
+                    base = MAP_FAILED;
+                }
+                ::close(fd);
+
+                if (base == MAP_FAILED) {
+                    length = 0;
+                    return nullptr;
+                }
+                return reinterpret_cast<const char*>(base);
+            }
+#endif
+
+            const char* data{nullptr};
+            size_t mapped{0};
+        };
+
+        inline std::string defaultLoadFileFn(const std::string& name) {
+            size_t size = 0;
+            auto file = openFile(name, size);
+            if (!file)
+                throw NotFound();
+            std::string source(size, '\0');
+            source.resize(std::fread(&source[0], 1, size, file.get()));
+            return source;
         }
 
         inline void defaultPrintFn(const char* text) {
             std::cout << text;
         }
 
+        // Module names with this prefix belong to this library, they never reach the user resolver or loader
+        inline bool isReservedModule(const std::string& name) {
+            return name.compare(0, 11, "wrenbind17:") == 0;
+        }
+
+        // The "wrenbind17:maps" module, scripts convert native maps into something C++ can read via MapEntries.of(_)
+        inline void createMapsModule(ForeignModule& m) {
+            auto& tag = m.klass<MapEntriesTag>("MapEntriesTag");
+            tag.ctor<>();
+            m.append(R"(
+class MapEntries {
+    static of(map) {
+        if (!(map is Map)) Fiber.abort("Expected a map")
+        if (__tag == null) __tag = MapEntriesTag.new()
+        return [__tag, map.keys.toList, map.values.toList]
+    }
+}
+)");
+        }
+
         inline std::string defaultPathResolveFn(const std::vector<std::string>& paths, const std::string& importer,
                                                 const std::string& name) {
             for (const auto& path : paths) {
                 const auto test = path + "/" + std::string(name) + ".wren";
 
-                std::ifstream t(test);
-                if (!t)
+                FileStat st;
+                if (!statFile(test, st))
                     continue;
 
                 return test;
@@ -63,6 +250,107 @@ namespace wrenbind17 {
 
             return name;
         }
+
+        // Key of the resolved import cache
+        inline std::string importKey(const std::string& importer, const std::string& name) {
+            auto key = importer;
+            key.push_back('\0');
+            key += name;
+            return key;
+        }
+
+        // Skips a string literal, including interpolated expressions, returns the position after it
+        inline const char* skipWrenString(const char* p, const char* end);
+
+        inline const char* skipWrenInterpolation(const char* p, const char* end) {
+            size_t depth = 1;
+            while (p < end) {
+                if (*p == '"') {
+                    p = skipWrenString(p, end);
+                    continue;
+                }
+                if (*p == '(')
+                    depth++;
+                else if (*p == ')' && --depth == 0)
+                    return p + 1;
+                p++;
+            }
+            return p;
+        }
+
+        inline const char* skipWrenString(const char* p, const char* end) {
+            if (end - p >= 3 && std::strncmp(p, "\"\"\"", 3) == 0) {
+                const auto* found = std::search(p + 3, end, "\"\"\"", "\"\"\"" + 3);
+                return found == end ? end : found + 3;
+            }
+            p++;
+            while (p < end) {
+                if (*p == '\\')
+                    p += 2;
+                else if (*p == '"')
+                    return p + 1;
+                else if (*p == '%' && p + 1 < end && p[1] == '(')
+                    p = skipWrenInterpolation(p + 2, end);
+                else
+                    p++;
+            }
+            return end;
+        }
+
+        // Returns the module names of all import statements, comments and strings are skipped
+        inline std::vector<std::string> scanImports(const std::string_view& source) {
+            std::vector<std::string> res;
+            const char* p = source.data();
+            const char* end = p + source.size();
+
+            const auto isName = [](const char c) -> bool {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+            };
+
+            while (p < end) {
+                if (*p == '/' && p + 1 < end && p[1] == '/') {
+                    while (p < end && *p != '\n')
+                        p++;
+                } else if (*p == '/' && p + 1 < end && p[1] == '*') {
+                    // Block comments can be nested
+                    size_t depth = 1;
+                    p += 2;
+                    while (p < end && depth > 0) {
+                        if (*p == '/' && p + 1 < end && p[1] == '*') {
+                            depth++;
+                            p += 2;
+                        } else if (*p == '*' && p + 1 < end && p[1] == '/') {
+                            depth--;
+                            p += 2;
+                        } else {
+                            p++;
+                        }
+                    }
+                } else if (*p == '"') {
+                    p = skipWrenString(p, end);
+                } else if (isName(*p)) {
+                    const char* start = p;
+                    while (p < end && isName(*p))
+                        p++;
+                    if (p - start != 6 || std::strncmp(start, "import", 6) != 0)
+                        continue;
+                    while (p < end && std::isspace(static_cast<unsigned char>(*p)))
+                        p++;
+                    if (p == end || *p != '"')
+                        continue;
+                    const char* name = ++p;
+                    while (p < end && *p != '"' && *p != '\n')
+                        p++;
+                    res.emplace_back(name, p);
+                    if (p < end && *p == '"')
+                        p++;
+                } else {
+                    p++;
+                }
+            }
+
+            return res;
+        }
     } // namespace detail
 
     /**
@@ -75,6 +363,12 @@ namespace wrenbind17 {
      */
     typedef std::function<std::string(const std::string& name)> LoadFileFn;
 
+    /**
+     * @ingroup wrenbind17
+     * @see VM::setLoadSourceFunc
+     */
+    typedef std::function<const char*(const std::string& name)> LoadSourceFn;
+
     /**
      * @ingroup wrenbind17
      */
@@ -82,6 +376,19 @@ namespace wrenbind17 {
                                       const std::string& name)>
         PathResolveFn;
 
+    /**
+     * @ingroup wrenbind17
+     * @see VM::lazyModule
+     */
+    typedef std::function<void(ForeignModule& module)> ModuleFactoryFn;
+
+    /**
+     * @ingroup wrenbind17
+     * @brief Runs task(0) to task(count - 1) and returns once all of them are done
+     * @see VM::prefetch
+     */
+    typedef std::function<void(size_t count, const std::function<void(size_t index)>& task)> ExecutorFn;
+
     /**
      * @ingroup wrenbind17
      * @brief Holds the entire Wren VM from which all of the magic happens
@@ -124,7 +431,17 @@ namespace wrenbind17 {
                 auto res = WrenLoadModuleResult();
                 auto& self = *reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
 
-                const auto mod = self.modules.find(name);
+                auto mod = self.modules.end();
+                try {
+                    mod = self.findModule(name);
+                } catch (std::exception& e) {
+                    // The factory of a lazy module has failed
+                    self.setNextError(e.what());
+                    return res;
+                } catch (...) {
+                    self.setNextError("Failed to create module " + std::string(name));
+                    return res;
+                }
                 if (mod != self.modules.end()) {
                     auto source = mod->second.str();
                     auto buffer = new char[source.size() + 1];
@@ -135,6 +452,35 @@ namespace wrenbind17 {
                     };
                     return res;
                 }
+                if (detail::isReservedModule(name))
+                    return res;
+
+                if (self.loadSourceFn) {
+                    // The source is owned by the loader, Wren reads it without freeing it
+                    try {
+                        res.source = self.loadSourceFn(std::string(name));
+                    } catch (...) {
+                        // The import has been cancelled by the loader
+                    }
+                    return res;
+                }
+
+                // Prefetched sources and the default loader map or read the file straight
+                // into the memory given to Wren
+                detail::FileSource source;
+                if (!self.takePrefetched(name, source) && self.defaultLoadFile)
+                    source = detail::FileSource(name);
+                if (source.get()) {
+                    size_t length = 0;
+                    res.source = source.release(length);
+                    res.userData = reinterpret_cast<void*>(length);
+                    res.onComplete = [](WrenVM* vm, const char* name, struct WrenLoadModuleResult result) {
+                        detail::FileSource::free(result.source, reinterpret_cast<size_t>(result.userData));
+                    };
+                    return res;
+                }
+                if (self.defaultLoadFile)
+                    return res;
 
                 try {
                     auto source = self.loadFileFn(std::string(name));
@@ -144,14 +490,15 @@ namespace wrenbind17 {
                     res.onComplete = [](WrenVM* vm, const char* name, struct WrenLoadModuleResult result) {
                         delete[] result.source;
                     };
-                } catch (std::exception& e) {
-                    (void)e;
+                } catch (...) {
+                    // The import has been cancelled by the loader
                 }
                 return res;
             };
             data->config.resolveModuleFn = [](WrenVM* vm, const char* importer, const char* name) -> const char* {
                 auto& self = *reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
-                const auto resolved = self.pathResolveFn(self.paths, std::string(importer), std::string(name));
+                const auto resolved =
+                    detail::isReservedModule(name) ? std::string(name) : self.resolveImport(importer, name);
                 auto buffer = new char[resolved.size() + 1];
                 std::memcpy(buffer, &resolved[0], resolved.size() + 1);
 
@@ -162,21 +509,56 @@ namespace wrenbind17 {
             data->config.loadModuleFn = [](WrenVM* vm, const char* name) -> char* {
                 auto& self = *reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
 
-                const auto mod = self.modules.find(name);
+                auto mod = self.modules.end();
+                try {
+                    mod = self.findModule(name);
+                } catch (std::exception& e) {
+                    // The factory of a lazy module has failed
+                    self.setNextError(e.what());
+                    return nullptr;
+                } catch (...) {
+                    self.setNextError("Failed to create module " + std::string(name));
+                    return nullptr;
+                }
                 if (mod != self.modules.end()) {
                     auto source = mod->second.str();
                     auto buffer = new char[source.size() + 1];
                     std::memcpy(buffer, &source[0], source.size() + 1);
                     return buffer;
                 }
+                if (detail::isReservedModule(name))
+                    return nullptr;
+
+                if (self.loadSourceFn) {
+                    // Wren frees the returned source, so it has to be copied
+                    try {
+                        const auto source = self.loadSourceFn(std::string(name));
+                        if (!source)
+                            return nullptr;
+                        const auto length = std::strlen(source);
+                        auto buffer = new char[length + 1];
+                        std::memcpy(buffer, source, length + 1);
+                        return buffer;
+                    } catch (...) {
+                        // The import has been cancelled by the loader
+                        return nullptr;
+                    }
+                }
+
+                // Prefetched sources are never mapped before Wren 0.4, so the buffer can be handed over
+                detail::FileSource prefetched;
+                if (self.takePrefetched(name, prefetched)) {
+                    size_t length = 0;
+                    return const_cast<char*>(prefetched.release(length));
+                }
 
                 try {
                     auto source = self.loadFileFn(self.paths, std::string(name));
                     auto buffer = new char[source.size() + 1];
                     std::memcpy(buffer, &source[0], source.size() + 1);
                     return buffer;
-                } catch (std::exception& e) {
-                    (void)e;
+                } catch (...) {
+                    // The import has been cancelled by the loader
                     return nullptr;
                 }
             };
@@ -184,15 +566,18 @@ namespace wrenbind17 {
             data->config.bindForeignMethodFn = [](WrenVM* vm, const char* module, const char* className,
                                                   const bool isStatic, const char* signature) -> WrenForeignMethodFn {
                 auto& self = *reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
-                try {
-                    auto& found = self.modules.at(module);
-                    auto& klass = found.findKlass(className);
-                    return klass.findSignature(signature, isStatic);
-                } catch (...) {
-                    std::cerr << "Wren foreign method " << signature << " not found in C++" << std::endl;
-                    std::abort();
-                    return nullptr;
+                WrenForeignMethodFn fn = nullptr;
+                const auto found = self.modules.find(module);
+                if (found != self.modules.end()) {
+                    auto* klass = found->second.lookupKlass(className);
+                    if (klass)
+                        fn = klass->lookupSignature(signature, isStatic);
                 }
+                // Wren reports a missing foreign method as an error of the module being run
+                if (!fn)
+                    self.setNextError(std::string("Wren foreign method ") + className + "." + signature +
+                                      " not found in C++ module " + module);
+                return fn;
             };
             data->config.bindForeignClassFn = [](WrenVM* vm, const char* module,
                                                  const char* className) -> WrenForeignClassMethods {
@@ -235,7 +620,12 @@ namespace wrenbind17 {
                 self.lastError += ss.str();
             };
 
-            data->vm = std::shared_ptr<WrenVM>(wrenNewVM(&data->config), [](WrenVM* ptr) { wrenFreeVM(ptr); });
+            // Wren finalizes the remaining objects when the VM is freed, the queue must outlive it
+            data->vm = std::shared_ptr<WrenVM>(wrenNewVM(&data->config), [releases = data->releases](WrenVM* ptr) {
+                wrenFreeVM(ptr);
+                releases->drain(0);
+            });
+            data->lazyModules["wrenbind17:maps"] = detail::createMapsModule;
         }
 
         inline VM(const VM& other) = delete;
@@ -267,6 +657,7 @@ namespace wrenbind17 {
          * @throws CompileError if the compilation has failed
          */
         inline void runFromSource(const std::string& name, const std::string& code) {
+            const detail::CallScope scope(data->vm.get());
             const auto result = wrenInterpret(data->vm.get(), name.c_str(), code.c_str());
             if (result != WREN_RESULT_SUCCESS) {
                 throw CompileError(getLastError());
@@ -283,24 +674,173 @@ namespace wrenbind17 {
          * @throws CompileError if the compilation has failed
          */
         inline void runFromFile(const std::string& name, const std::string& path) {
-            std::ifstream t(path);
-            if (!t)
+            const detail::FileSource source(path);
+            if (!source.get())
                 throw Exception("Compile error: Failed to open source file");
-            std::string str((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
-            runFromSource(name, str);
+            const detail::CallScope scope(data->vm.get());
+            const auto result = wrenInterpret(data->vm.get(), name.c_str(), source.get());
+            if (result != WREN_RESULT_SUCCESS) {
+                throw CompileError(getLastError());
+            }
         }
 
         /*!
          * @brief Runs a Wren source code by passing it as a string
          * @see setLoadFileFunc
+         * @see setLoadSourceFunc
          * @param name The module name to load, this will use the loader function to
          * load the file from
          * @throws CompileError if the compilation has failed
          */
         inline void runFromModule(const std::string& name) {
-            const auto resolved = data->pathResolveFn(data->paths, "", name);
-            const auto source = data->loadFileFn(resolved);
-            runFromSource(resolved, source);
+            const auto resolved = data->resolveImport("", name);
+            if (data->loadSourceFn) {
+                const auto source = data->loadSourceFn(resolved);
+                if (!source)
+                    throw NotFound();
+                const detail::CallScope scope(data->vm.get());
+                const auto result = wrenInterpret(data->vm.get(), resolved.c_str(), source);
+                if (result != WREN_RESULT_SUCCESS)
+                    throw CompileError(getLastError());
+                return;
+            }
+            detail::FileSource prefetched;
+            if (data->takePrefetched(resolved, prefetched)) {
+                const detail::CallScope scope(data->vm.get());
+                const auto result = wrenInterpret(data->vm.get(), resolved.c_str(), prefetched.get());
+                if (result != WREN_RESULT_SUCCESS)
+                    throw CompileError(getLastError());
+                return;
+            }
+            runFromSource(resolved, data->loadFileFn(resolved));
+        }
+
+        /*!
+         * @brief Reads the scripts imported by a module ahead of time
+         * @details Scans the import statements of the module and of its imports transitively.
+         * The sources are kept in memory until they are imported or run via runFromModule().
+         * Call this before runFromModule() when the scripts are on a slow filesystem.
+         *
+         * Each level of imports is resolved and read via the executor, which may run the tasks
+         * in parallel, for example the one returned by wrenbind17::threadExecutor() from
+         * prefetch.hpp. Without an executor the tasks run one after another on this thread.
+         * Each resolved path is read only once, even if it is imported by multiple modules.
+         *
+         * Modules added via module() or lazyModule() are skipped, and so are the modules that
+         * have already been imported. Imports that fail to resolve or load are skipped as well,
+         * and report their error once they are imported. When the executor runs the tasks in
+         * parallel, custom functions set via setPathResolveFunc() or setLoadFileFunc() must be
+         * thread safe.
+         * @param name The module name as passed to runFromModule()
+         * @param executor Runs the tasks of each level of imports
+         * @returns The number of prefetched modules
+         */
+        inline size_t prefetch(const std::string& name, const ExecutorFn& executor = nullptr) {
+            struct Job {
+                std::string importer;
+                std::string name;
+                std::string path;
+                detail::FileStat stat;
+                bool found{false};
+                bool resolved{false};
+                detail::FileSource source;
+            };
+
+            // Sources served by setLoadSourceFunc() are already in memory
+            if (data->loadSourceFn)
+                return 0;
+
+            const auto run = [&](const size_t count, const std::function<void(size_t)>& task) {
+                if (executor) {
+                    executor(count, task);
+                    return;
+                }
+                for (size_t i = 0; i < count; i++) {
+                    task(i);
+                }
+            };
+
+            std::unordered_set<std::string> visited;
+            std::vector<Job> wave(1);
+            wave[0].name = name;
+            size_t count = 0;
+
+            while (!wave.empty()) {
+                // The tasks only touch their own job, the data is only modified in between
+                run(wave.size(), [&](const size_t i) {
+                    auto& job = wave[i];
+                    try {
+                        job.path = data->pathResolveFn(data->paths, job.importer, job.name);
+                        job.found = detail::statFile(job.path, job.stat);
+                        job.resolved = true;
+                    } catch (...) {
+                    }
+                });
+
+                // Claims each resolved path once, so that a module imported from multiple
+                // modules of the same level is read only once
+                std::unordered_set<std::string> claimed;
+                std::vector<Job*> loads;
+                for (auto& job : wave) {
+                    if (!job.resolved)
+                        continue;
+                    if (data->importCache && job.found)
+                        data->resolvedImports[detail::importKey(job.importer, job.name)] =
+                            ResolvedImport{job.path, job.stat};
+                    if (data->prefetched.find(job.path) != data->prefetched.end())
+                        continue;
+#if WREN_VERSION_NUMBER >= 4000 // >= 0.4.0
+                    if (wrenHasModule(data->vm.get(), job.path.c_str()))
+                        continue;
+#endif
+                    if (claimed.insert(job.path).second)
+                        loads.push_back(&job);
+                }
+
+                run(loads.size(), [&](const size_t i) {
+                    auto& job = *loads[i];
+                    try {
+                        if (data->defaultLoadFile) {
+#if WREN_VERSION_NUMBER >= 4000 // >= 0.4.0
+                            job.source = detail::FileSource(job.path);
+#else
+                            // Wren frees the source of an import before 0.4, so it can not be mapped
+                            job.source = detail::FileSource(detail::readFileBuffer(job.path));
+#endif
+                            return;
+                        }
+                        // Copied once here, so that the import does not need to copy it again
+                        const auto source = data->loadFileFn(job.path);
+                        std::unique_ptr<char[]> buffer(new char[source.size() + 1]);
+                        std::memcpy(buffer.get(), source.c_str(), source.size() + 1);
+                        job.source = detail::FileSource(std::move(buffer));
+                    } catch (...) {
+                    }
+                });
+
+                std::vector<Job> imports;
+                for (auto* job : loads) {
+                    if (!job->source.get())
+                        continue;
+
+                    for (auto& import : detail::scanImports(job->source.get())) {
+                        if (data->modules.count(import) || data->lazyModules.count(import) ||
+                            detail::isReservedModule(import))
+                            continue;
+                        if (!visited.insert(detail::importKey(job->path, import)).second)
+                            continue;
+                        imports.emplace_back();
+                        imports.back().importer = job->path;
+                        imports.back().name = std::move(import);
+                    }
+
+                    data->prefetched[job->path] = std::move(job->source);
+                    count++;
+                }
+                wave = std::move(imports);
+            }
+
+            return count;
         }
 
         /*!
@@ -319,19 +859,51 @@ namespace wrenbind17 {
             return Variable(std::make_shared<Handle>(data->vm, handle));
         }
 
+        /*!
+         * @brief Creates a new empty native Wren list
+         */
+        inline List createList() {
+            wrenEnsureSlots(data->vm.get(), 1);
+            wrenSetSlotNewList(data->vm.get(), 0);
+            return List(std::make_shared<Handle>(data->vm, wrenGetSlotHandle(data->vm.get(), 0)));
+        }
+
         /*!
          * @brief Creates a new custom module
          * @note Calling this function multiple times with the same name
          * does not create a new module, but instead it returns the same module.
          */
         inline ForeignModule& module(const std::string& name) {
-            auto it = data->modules.find(name);
+            if (detail::isReservedModule(name))
+                throw Exception("Module " + name + " is reserved");
+            auto it = data->findModule(name);
             if (it == data->modules.end()) {
                 it = data->modules.insert(std::make_pair(name, ForeignModule(name, data->vm.get()))).first;
             }
             return it->second;
         }
 
+        /*!
+         * @brief Registers a module that is only created when it is imported for the first time
+         * @details The factory is called with an empty module the first time a script imports
+         * the module, or when the module is accessed via module(). Until then, the classes
+         * of this module are not registered, so their instances can not be passed into Wren.
+         * @throws Exception if a module with the same name exists or is already registered
+         * @code
+         * vm.lazyModule("physics", [](wren::ForeignModule& m) {
+         *     auto& cls = m.klass<Body>("Body");
+         *     cls.ctor<>();
+         * });
+         * @endcode
+         */
+        inline void lazyModule(const std::string& name, ModuleFactoryFn fn) {
+            if (detail::isReservedModule(name))
+                throw Exception("Module " + name + " is reserved");
+            if (data->modules.find(name) != data->modules.end() || data->lazyModules.count(name))
+                throw Exception("Module " + name + " already exists");
+            data->lazyModules.emplace(name, std::move(fn));
+        }
+
         inline void addClassType(const std::string& module, const std::string& name, const size_t hash) {
             data->addClassType(module, name, hash);
         }
@@ -379,6 +951,20 @@ namespace wrenbind17 {
          */
         inline void setLoadFileFunc(const LoadFileFn& fn) {
             data->loadFileFn = fn;
+            data->defaultLoadFile = false;
+            data->loadSourceFn = nullptr;
+        }
+
+        /*!
+         * @brief Set a custom loader for imports that returns sources owned by the caller
+         * @see LoadSourceFn
+         * @details Same as setLoadFileFunc() but the function returns a null terminated source
+         * that stays valid for as long as the VM exists, for example a pointer into a memory mapped
+         * archive. The source is given to Wren without copying. Return nullptr or throw an exception
+         * to cancel the import. Replaces the function set via setLoadFileFunc().
+         */
+        inline void setLoadSourceFunc(const LoadSourceFn& fn) {
+            data->loadSourceFn = fn;
         }
 
         /*!
@@ -393,21 +979,96 @@ namespace wrenbind17 {
          */
         inline void setPathResolveFunc(const PathResolveFn& fn) {
             data->pathResolveFn = fn;
+            data->resolvedImports.clear();
+        }
+
+        /*!
+         * @brief Enables or disables caching of the resolved import paths
+         * @details The cache is enabled by default. A cached path is checked with a single
+         * stat() call on each import. Disable it if your resolver does not return file paths.
+         */
+        inline void setImportCache(const bool enabled) {
+            data->importCache = enabled;
+            data->resolvedImports.clear();
+        }
+
+        /*!
+         * @brief Releases the Wren object of a C++ instance of a class with identity enabled
+         * @see ForeignKlassImpl::identity()
+         * @returns true if there was a Wren object for this instance
+         */
+        template <typename T> bool releaseIdentity(const T* ptr) {
+            return data->releaseIdentity(typeid(T).hash_code(), ptr);
+        }
+
+        /*!
+         * @brief Releases the Wren objects of all C++ instances of classes with identity enabled
+         * @see ForeignKlassImpl::identity()
+         */
+        inline void releaseIdentities() {
+            data->releaseIdentities();
         }
 
         /*!
          * @brief Runs the garbage collector
+         * @details The Wren objects of shared instances with identity enabled are released
+         * first if no C++ shared pointer owns the instance anymore.
+         * @see ForeignKlassImpl::identity()
          */
         inline void gc() {
+            data->sweepIdentities();
             wrenCollectGarbage(data->vm.get());
         }
 
+        /*!
+         * @brief Destroys the C++ instances of classes with deferred release
+         * @details Each VM has its own queue, this is safe to call from any thread,
+         * for example from a background thread or once per frame. The instances that are
+         * still queued are destroyed with the VM.
+         * @param max The maximum number of instances to destroy, zero means all of them
+         * @returns The number of released instances
+         * @see ForeignKlassImpl::deferRelease()
+         */
+        inline size_t drainReleases(const size_t max = 0) {
+            return data->releases->drain(max);
+        }
+
+        /*!
+         * @brief Returns the number of instances waiting for drainReleases()
+         */
+        inline size_t pendingReleases() const {
+            return data->releases->size();
+        }
+
+        struct ResolvedImport {
+            std::string path;
+            detail::FileStat stat;
+        };
+
+        typedef std::pair<size_t, size_t> IdentityKey;
+
+        // The Wren objects of a C++ instance of a class with identity enabled
+        struct Identity {
+            WrenHandle* borrowed{nullptr};
+            WrenHandle* owned{nullptr};
+            std::weak_ptr<const void> owner;
+            // Position in IdentityClass::borrowed, valid only if there is a borrowed Wren object
+            std::list<IdentityKey>::iterator order;
+        };
+
+        // The borrowed Wren objects of a class, from the least recently pushed one
+        struct IdentityClass {
+            size_t limit{0};
+            std::list<IdentityKey> borrowed;
+        };
+
         class Data {
         public:
             std::shared_ptr<WrenVM> vm;
             WrenConfiguration config;
             std::vector<std::string> paths;
             std::unordered_map<std::string, ForeignModule> modules;
+            std::unordered_map<std::string, ModuleFactoryFn> lazyModules;
             std::unordered_map<size_t, std::string> classToModule;
             std::unordered_map<size_t, std::string> classToName;
             std::unordered_map<std::pair<size_t, size_t>, std::shared_ptr<detail::ForeignPtrConvertor>> classCasting;
@@ -415,7 +1076,108 @@ namespace wrenbind17 {
             std::string nextError;
             PrintFn printFn;
             LoadFileFn loadFileFn;
+            bool defaultLoadFile{true};
+            LoadSourceFn loadSourceFn;
             PathResolveFn pathResolveFn;
+            std::unordered_map<std::string, ResolvedImport> resolvedImports;
+            bool importCache{true};
+            std::unordered_map<std::string, detail::FileSource> prefetched;
+            std::unordered_map<size_t, IdentityClass> identityClasses;
+            std::unordered_map<IdentityKey, Identity> identities;
+            size_t identitySweep{64};
+            std::unordered_set<size_t> deferredClasses;
+            std::shared_ptr<detail::ReleaseQueue> releases{std::make_shared<detail::ReleaseQueue>()};
+
+            WrenHandle* mapEntriesClass{nullptr};
+            WrenHandle* mapEntriesCall{nullptr};
+            size_t callDepth{0};
+
+            inline ~Data() {
+                releaseIdentities();
+                if (vm && mapEntriesClass) {
+                    wrenReleaseHandle(vm.get(), mapEntriesClass);
+                    wrenReleaseHandle(vm.get(), mapEntriesCall);
+                }
+                releases->drain(0);
+            }
+
+            // Converts a native map via MapEntries.of(_), the result is put into slot 0
+            inline void callMapEntries(WrenHandle* map) {
+                // wrenCall would overwrite the slots of the foreign function being run
+                if (callDepth != 0)
+                    throw BadCast("Bad cast native Wren maps can not be converted while Wren is running, "
+                                  "pass MapEntries.of(map) from the \"wrenbind17:maps\" module instead");
+
+                const detail::CallScope scope(vm.get());
+                if (!mapEntriesClass) {
+                    const auto result =
+                        wrenInterpret(vm.get(), "wrenbind17:host", "import \"wrenbind17:maps\" for MapEntries");
+                    if (result != WREN_RESULT_SUCCESS)
+                        throw RuntimeError(getLastError());
+                    wrenEnsureSlots(vm.get(), 1);
+                    wrenGetVariable(vm.get(), "wrenbind17:maps", "MapEntries", 0);
+                    mapEntriesClass = wrenGetSlotHandle(vm.get(), 0);
+                    mapEntriesCall = wrenMakeCallHandle(vm.get(), "of(_)");
+                }
+                wrenEnsureSlots(vm.get(), 2);
+                wrenSetSlotHandle(vm.get(), 0, mapEntriesClass);
+                wrenSetSlotHandle(vm.get(), 1, map);
+                if (wrenCall(vm.get(), mapEntriesCall) != WREN_RESULT_SUCCESS)
+                    throw RuntimeError(getLastError());
+            }
+
+            // Resolved paths are reused for as long as the file has the same size and modification time
+            inline std::string resolveImport(const std::string& importer, const std::string& name) {
+                if (!importCache)
+                    return pathResolveFn(paths, importer, name);
+
+                auto key = detail::importKey(importer, name);
+
+                detail::FileStat st;
+                const auto it = resolvedImports.find(key);
+                if (it != resolvedImports.end()) {
+                    if (detail::statFile(it->second.path, st) && st == it->second.stat)
+                        return it->second.path;
+                    resolvedImports.erase(it);
+                }
+
+                auto path = pathResolveFn(paths, importer, name);
+                if (detail::statFile(path, st))
+                    resolvedImports[std::move(key)] = ResolvedImport{path, st};
+                return path;
+            }
+
+            // Moves out the source read by VM::prefetch(), each source is used once
+            inline bool takePrefetched(const std::string& name, detail::FileSource& out) {
+                if (prefetched.empty())
+                    return false;
+                const auto it = prefetched.find(name);
+                if (it == prefetched.end())
+                    return false;
+                out = std::move(it->second);
+                prefetched.erase(it);
+                return true;
+            }
+
+            // Runs the factory of a lazy module the first time it is needed
+            inline std::unordered_map<std::string, ForeignModule>::iterator findModule(const std::string& name) {
+                auto it = modules.find(name);
+                if (it != modules.end() || lazyModules.empty())
+                    return it;
+                auto lazy = lazyModules.find(name);
+                if (lazy == lazyModules.end())
+                    return it;
+                const auto fn = std::move(lazy->second);
+                lazyModules.erase(lazy);
+                it = modules.insert(std::make_pair(name, ForeignModule(name, vm.get()))).first;
+                try {
+                    fn(it->second);
+                } catch (...) {
+                    modules.erase(it);
+                    throw;
+                }
+                return it;
+            }
 
             inline void addClassType(const std::string& module, const std::string& name, const size_t hash) {
                 classToModule.insert(std::make_pair(hash, module));
@@ -449,6 +1211,144 @@ namespace wrenbind17 {
             inline void setNextError(std::string str) {
                 nextError = std::move(str);
             }
+
+            inline void enableIdentity(const size_t hash, const size_t limit) {
+                auto& cls = identityClasses[hash];
+                cls.limit = limit;
+                while (cls.borrowed.size() > cls.limit) {
+                    releaseBorrowed(cls, cls.borrowed.front());
+                }
+            }
+
+            inline void enableDeferredRelease(const size_t hash) {
+                deferredClasses.insert(hash);
+            }
+
+            inline detail::ReleaseQueue* getReleaseQueue(const size_t hash) const {
+                if (deferredClasses.empty() || deferredClasses.find(hash) == deferredClasses.end())
+                    return nullptr;
+                return releases.get();
+            }
+
+            inline WrenHandle* findIdentity(const size_t hash, const void* ptr, const bool owned) {
+                if (identities.empty())
+                    return nullptr;
+                const auto it = identities.find(IdentityKey(hash, reinterpret_cast<size_t>(ptr)));
+                if (it == identities.end())
+                    return nullptr;
+                // A borrowed Wren object does not keep the instance alive, it is never reused for a shared pointer
+                auto& entry = it->second;
+                if (owned || entry.owned)
+                    return entry.owned;
+                if (entry.borrowed) {
+                    auto& order = identityClasses[hash].borrowed;
+                    order.splice(order.end(), order, entry.order);
+                }
+                return entry.borrowed;
+            }
+
+            // Whether a shared instance popped from Wren should be remembered again, the Wren object
+            // of a shared instance is forgotten by sweepIdentities() while only Wren owns it
+            inline bool needsIdentity(const size_t hash, const void* ptr) const {
+                if (identityClasses.empty() || identityClasses.find(hash) == identityClasses.end())
+                    return false;
+                const auto it = identities.find(IdentityKey(hash, reinterpret_cast<size_t>(ptr)));
+                return it == identities.end() || !it->second.owned;
+            }
+
+            inline void addIdentity(const size_t hash, const void* ptr, const int idx,
+                                    std::weak_ptr<const void> owner) {
+                const auto cls = identityClasses.find(hash);
+                if (cls == identityClasses.end())
+                    return;
+                const auto borrowed = owner.expired();
+                if (borrowed && cls->second.limit == 0)
+                    return;
+                if (identities.size() >= identitySweep) {
+                    sweepIdentities();
+                    identitySweep = std::max<size_t>(64, identities.size() * 2);
+                }
+
+                const IdentityKey key(hash, reinterpret_cast<size_t>(ptr));
+                auto& entry = identities[key];
+                auto*& handle = borrowed ? entry.borrowed : entry.owned;
+                if (handle) {
+                    wrenReleaseHandle(vm.get(), handle);
+                    if (borrowed)
+                        cls->second.borrowed.splice(cls->second.borrowed.end(), cls->second.borrowed, entry.order);
+                } else if (borrowed)
+                    entry.order = cls->second.borrowed.insert(cls->second.borrowed.end(), key);
+                handle = wrenGetSlotHandle(vm.get(), idx);
+                if (!borrowed)
+                    entry.owner = std::move(owner);
+
+                // Forgets the least recently pushed borrowed Wren objects over the limit
+                auto& order = cls->second.borrowed;
+                while (order.size() > cls->second.limit) {
+                    releaseBorrowed(cls->second, order.front());
+                }
+            }
+
+            inline bool releaseIdentity(const size_t hash, const void* ptr) {
+                const auto it = identities.find(IdentityKey(hash, reinterpret_cast<size_t>(ptr)));
+                if (it == identities.end())
+                    return false;
+                if (it->second.borrowed)
+                    identityClasses[hash].borrowed.erase(it->second.order);
+                releaseIdentity(it->second);
+                identities.erase(it);
+                return true;
+            }
+
+            inline void releaseIdentity(Identity& entry) {
+                if (entry.borrowed)
+                    wrenReleaseHandle(vm.get(), entry.borrowed);
+                if (entry.owned)
+                    wrenReleaseHandle(vm.get(), entry.owned);
+                entry.borrowed = nullptr;
+                entry.owned = nullptr;
+            }
+
+            // Releases the borrowed Wren object, the key must be in the list of the class
+            inline void releaseBorrowed(IdentityClass& cls, const IdentityKey key) {
+                const auto it = identities.find(key);
+                auto& entry = it->second;
+                cls.borrowed.erase(entry.order);
+                wrenReleaseHandle(vm.get(), entry.borrowed);
+                entry.borrowed = nullptr;
+                if (!entry.owned)
+                    identities.erase(it);
+            }
+
+            inline void releaseIdentities() {
+                if (vm) {
+                    for (auto& pair : identities) {
+                        releaseIdentity(pair.second);
+                    }
+                }
+                identities.clear();
+                for (auto& pair : identityClasses) {
+                    pair.second.borrowed.clear();
+                }
+            }
+
+            // Forgets the Wren objects of shared instances that are only owned by that Wren object,
+            // so the VM does not keep them alive. If C++ gets such an instance back from Wren,
+            // the Wren object is remembered again, see needsIdentity()
+            inline void sweepIdentities() {
+                for (auto it = identities.begin(); it != identities.end();) {
+                    auto& entry = it->second;
+                    if (entry.owned && entry.owner.use_count() <= 1) {
+                        wrenReleaseHandle(vm.get(), entry.owned);
+                        entry.owned = nullptr;
+                        entry.owner.reset();
+                    }
+                    if (!entry.owned && !entry.borrowed)
+                        it = identities.erase(it);
+                    else
+                        ++it;
+                }
+            }
         };
 
     private:
@@ -467,6 +1367,16 @@ namespace wrenbind17 {
         auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
         self->addClassType(module, name, hash);
     }
+    inline size_t& getCallDepth(WrenVM* vm) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        return self->callDepth;
+    }
+    inline void callMapEntries(WrenVM* vm, WrenHandle* map) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        self->callMapEntries(map);
+    }
     inline void getClassType(WrenVM* vm, std::string& module, std::string& name, const size_t hash) {
         assert(vm);
         auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
@@ -488,6 +1398,37 @@ namespace wrenbind17 {
         auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
         return self->getClassCast(hash, other);
     }
+    inline void enableIdentity(WrenVM* vm, const size_t hash, const size_t limit) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        self->enableIdentity(hash, limit);
+    }
+    inline void enableDeferredRelease(WrenVM* vm, const size_t hash) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        self->enableDeferredRelease(hash);
+    }
+    inline detail::ReleaseQueue* getReleaseQueue(WrenVM* vm, const size_t hash) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        return self->getReleaseQueue(hash);
+    }
+    inline WrenHandle* findIdentity(WrenVM* vm, const size_t hash, const void* ptr, const bool owned) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        return self->findIdentity(hash, ptr, owned);
+    }
+    inline bool needsIdentity(WrenVM* vm, const size_t hash, const void* ptr) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        return self->needsIdentity(hash, ptr);
+    }
+    inline void addIdentity(WrenVM* vm, const size_t hash, const void* ptr, const int idx,
+                            std::weak_ptr<const void> owner) {
+        assert(vm);
+        auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
+        self->addIdentity(hash, ptr, idx, std::move(owner));
+    }
     inline std::string getLastError(WrenVM* vm) {
         assert(vm);
         auto self = reinterpret_cast<VM::Data*>(wrenGetUserData(vm));
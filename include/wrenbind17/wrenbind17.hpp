@@ -5,12 +5,21 @@
  * @brief Wren lang binding library for C++17
  */
 
+#include "archive.hpp"
+#include "archiveview.hpp"
+#include "buffer.hpp"
+#include "entity.hpp"
+#include "listview.hpp"
+#include "math.hpp"
+#include "mapped.hpp"
 #include "std.hpp"
+#include "stdarray.hpp"
 #include "stddeque.hpp"
 #include "stdlist.hpp"
 #include "stdmap.hpp"
 #include "stdoptional.hpp"
 #include "stdset.hpp"
+#include "stdtuple.hpp"
 #include "stdvariant.hpp"
 #include "stdvector.hpp"
 #include "vm.hpp"
@@ -0,0 +1,98 @@
+# Helpers for shipping Wren scripts together with an application
+#
+# wrenbind17_add_archive(<target> DIRECTORY <dir> OUTPUT <file>)
+#
+#   Adds a target that packs all .wren files of <dir> into a single archive <file>,
+#   which can be loaded at runtime via wrenbind17::Archive. The module names are the
+#   file paths relative to <dir> without the ".wren" extension.
+#
+# wrenbind17_embed_scripts(<target> DIRECTORY <dir> [NAME <name>])
+#
+#   Embeds all .wren files of <dir> into <target> as a generated source file, so no
+#   files are read at runtime. Wren has no bytecode format, so the sources are embedded.
+#   Include "<name>.hpp" and call "<name>().install(vm)" to serve the imports from it.
+#   The <name> defaults to "<target>Scripts" and must be a valid C++ identifier.
+#
+# With CMake older than 3.12 the scripts are globbed only when CMake runs, so re-run
+# CMake after adding or removing a script. Newer versions re-glob on every build.
+
+set(WRENBIND17_TOOLS_DIR ${CMAKE_CURRENT_LIST_DIR}/../tools CACHE INTERNAL "")
+
+function(wrenbind17_glob_scripts OUTPUT DIRECTORY)
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.12)
+    file(GLOB_RECURSE SCRIPTS CONFIGURE_DEPENDS ${DIRECTORY}/*.wren)
+  else()
+    file(GLOB_RECURSE SCRIPTS ${DIRECTORY}/*.wren)
+  endif()
+  set(${OUTPUT} ${SCRIPTS} PARENT_SCOPE)
+endfunction()
+
+function(wrenbind17_add_pack_tool)
+  if(TARGET wrenbind17_pack)
+    return()
+  endif()
+  add_executable(wrenbind17_pack ${WRENBIND17_TOOLS_DIR}/wrenbind17_pack.cpp)
+  set_target_properties(wrenbind17_pack PROPERTIES CXX_STANDARD 17 CXX_EXTENSIONS OFF)
+  # Only the Wren independent archive format is used, see archiveview.hpp
+  target_include_directories(wrenbind17_pack PRIVATE ${WRENBIND17_TOOLS_DIR}/../include)
+  if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" AND CMAKE_CXX_COMPILER_VERSION VERSION_LESS 9.1)
+    target_link_libraries(wrenbind17_pack PRIVATE stdc++fs)
+  endif()
+endfunction()
+
+function(wrenbind17_add_archive TARGET)
+  cmake_parse_arguments(ARG "" "DIRECTORY;OUTPUT" "" ${ARGN})
+  if(NOT ARG_DIRECTORY OR NOT ARG_OUTPUT)
+    message(FATAL_ERROR "wrenbind17_add_archive: DIRECTORY and OUTPUT are required")
+  endif()
+  get_filename_component(ARG_DIRECTORY ${ARG_DIRECTORY} ABSOLUTE)
+  get_filename_component(ARG_OUTPUT ${ARG_OUTPUT} ABSOLUTE BASE_DIR ${CMAKE_CURRENT_BINARY_DIR})
+
+  wrenbind17_add_pack_tool()
+  wrenbind17_glob_scripts(SCRIPTS ${ARG_DIRECTORY})
+
+  add_custom_command(
+    OUTPUT ${ARG_OUTPUT}
+    COMMAND wrenbind17_pack ${ARG_DIRECTORY} ${ARG_OUTPUT}
+    DEPENDS wrenbind17_pack ${SCRIPTS}
+    COMMENT "Packing Wren scripts into ${ARG_OUTPUT}"
+    VERBATIM
+  )
+  add_custom_target(${TARGET} ALL DEPENDS ${ARG_OUTPUT})
+endfunction()
+
+function(wrenbind17_embed_scripts TARGET)
+  cmake_parse_arguments(ARG "" "DIRECTORY;NAME" "" ${ARGN})
+  if(NOT ARG_DIRECTORY)
+    message(FATAL_ERROR "wrenbind17_embed_scripts: DIRECTORY is required")
+  endif()
+  if(NOT ARG_NAME)
+    string(MAKE_C_IDENTIFIER "${TARGET}Scripts" ARG_NAME)
+  endif()
+  get_filename_component(ARG_DIRECTORY ${ARG_DIRECTORY} ABSOLUTE)
+  set(OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/wrenbind17_embed)
+  set(OUTPUT ${OUTPUT_DIR}/${ARG_NAME}.cpp)
+
+  # Written through configure_file(), which keeps the header untouched if it has
+  # not changed, so the sources including it are not rebuilt on every configure
+  file(WRITE ${OUTPUT_DIR}/${ARG_NAME}.hpp.tmp
+    "// Generated by wrenbind17_embed_scripts(), do not edit\n"
+    "#pragma once\n"
+    "#include <wrenbind17/archive.hpp>\n\n"
+    "const wrenbind17::Archive& ${ARG_NAME}();\n"
+  )
+  configure_file(${OUTPUT_DIR}/${ARG_NAME}.hpp.tmp ${OUTPUT_DIR}/${ARG_NAME}.hpp COPYONLY)
+
+  wrenbind17_add_pack_tool()
+  wrenbind17_glob_scripts(SCRIPTS ${ARG_DIRECTORY})
+
+  add_custom_command(
+    OUTPUT ${OUTPUT}
+    COMMAND wrenbind17_pack --embed ${ARG_NAME} ${ARG_DIRECTORY} ${OUTPUT}
+    DEPENDS wrenbind17_pack ${SCRIPTS}
+    COMMENT "Embedding Wren scripts into ${OUTPUT}"
+    VERBATIM
+  )
+  target_sources(${TARGET} PRIVATE ${OUTPUT})
+  target_include_directories(${TARGET} PRIVATE ${OUTPUT_DIR})
+endfunction()
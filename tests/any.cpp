@@ -57,3 +57,83 @@ TEST_CASE("Returning bad any must throw correct exception") {
         REQUIRE_NOTHROW(res.as<std::nullptr_t>());
     }
 }
+
+TEST_CASE("Small values are stored inline") {
+    const std::string code = R"(
+        import "test" for HelloClass
+
+        class Main {
+            static number() {
+                return 42.5
+            }
+
+            static boolean() {
+                return true
+            }
+
+            static shortString() {
+                return "Hello World"
+            }
+
+            static longString() {
+                return "Hello World Hello World Hello World"
+            }
+
+            static instance() {
+                return HelloClass.new()
+            }
+
+            static list() {
+                return [1, 2, 3]
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& c = m.klass<HelloClass>("HelloClass");
+    c.ctor<>();
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    SECTION("Numbers") {
+        auto res = main.func("number()")();
+        REQUIRE(res.isInline());
+        REQUIRE(res.is<double>());
+        REQUIRE(res.as<double>() == Approx(42.5));
+        REQUIRE(res.as<int>() == 42);
+        REQUIRE(res.as<std::optional<double>>() == std::optional<double>(42.5));
+        REQUIRE_THROWS_WITH(res.as<std::string>(), Catch::Contains("got number expected string"));
+    }
+
+    SECTION("Booleans") {
+        auto res = main.func("boolean()")();
+        REQUIRE(res.isInline());
+        REQUIRE(res.is<bool>());
+        REQUIRE(res.as<bool>() == true);
+    }
+
+    SECTION("Strings") {
+        auto res = main.func("shortString()")();
+        REQUIRE(res.isInline());
+        REQUIRE(res.as<std::string>() == "Hello World");
+        REQUIRE_THROWS_AS(res.as<int>(), wren::BadCast);
+
+        res = main.func("longString()")();
+        REQUIRE_FALSE(res.isInline());
+        REQUIRE(res.as<std::string>() == "Hello World Hello World Hello World");
+    }
+
+    SECTION("Objects") {
+        auto res = main.func("instance()")();
+        REQUIRE_FALSE(res.isInline());
+        REQUIRE(res.is<HelloClass>());
+        REQUIRE_FALSE(res.is<std::string>());
+        REQUIRE(res.as<HelloClass*>() != nullptr);
+
+        res = main.func("list()")();
+        REQUIRE_FALSE(res.isInline());
+        REQUIRE(res.as<std::vector<int>>() == std::vector<int>{1, 2, 3});
+    }
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+TEST_CASE("Buffers") {
+    const std::string code = R"(
+        import "test" for Float64Array, Float32Array, Int32Array, ByteArray
+
+        class Main {
+            static create() {
+                var buffer = Float64Array.new(4)
+                buffer.fill(1.5)
+                buffer[3] = 2.5
+                return buffer.sum()
+            }
+
+            static iterate() {
+                var buffer = Int32Array.new(3)
+                buffer[0] = 1
+                buffer[1] = 2
+                buffer[2] = 3
+                var sum = 0
+                for (value in buffer) {
+                    sum = sum + value
+                }
+                return sum
+            }
+
+            static modify(buffer) {
+                buffer[0] = 10
+                buffer.map("square")
+                return buffer.count
+            }
+
+            static dot(a, b) {
+                return a.dot(b)
+            }
+
+            static copy(a, b) {
+                a.copy(b)
+                return a.toList()
+            }
+
+            static badKernel(buffer) {
+                buffer.map("unknown")
+            }
+
+            static outOfRange(buffer) {
+                return buffer[buffer.count]
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    wren::bindBuffers(m);
+
+    vm.runFromSource("main", code);
+    auto cls = vm.find("main", "Main");
+
+    SECTION("Create in Wren") {
+        REQUIRE(cls.func("create()")().as<double>() == Approx(7.0));
+        REQUIRE(cls.func("iterate()")().as<int>() == 6);
+    }
+
+    SECTION("Borrowed memory is not copied") {
+        std::vector<float> data = {1.0f, 2.0f, 3.0f};
+        wren::Float32Array buffer(data.data(), data.size());
+        REQUIRE(buffer.isBorrowed());
+
+        REQUIRE(cls.func("modify(_)")(&buffer).as<int>() == 3);
+        REQUIRE(data == std::vector<float>{100.0f, 4.0f, 9.0f});
+    }
+
+    SECTION("Borrowed memory with a guard") {
+        auto data = std::make_shared<std::vector<double>>(std::vector<double>{1.0, 2.0, 3.0});
+        wren::Float64Array a(data->data(), data->size(), data);
+        wren::Float64Array b(std::vector<double>{4.0, 5.0, 6.0});
+        REQUIRE_FALSE(b.isBorrowed());
+
+        data.reset();
+        REQUIRE(cls.func("dot(_,_)")(&a, &b).as<double>() == Approx(32.0));
+    }
+
+    SECTION("Copy between buffers") {
+        wren::ByteArray a(std::vector<uint8_t>{1, 2, 3, 4});
+        wren::ByteArray b(std::vector<uint8_t>{9, 8});
+        auto res = cls.func("copy(_,_)")(&a, &b).as<std::vector<int>>();
+        REQUIRE(res == std::vector<int>{9, 8, 3, 4});
+    }
+
+    SECTION("Errors") {
+        wren::Int32Array buffer(2);
+        REQUIRE_THROWS_WITH(cls.func("badKernel(_)")(&buffer), Catch::Contains("Buffer kernel 'unknown' not found"));
+        REQUIRE_THROWS_WITH(cls.func("outOfRange(_)")(&buffer), Catch::Contains("Buffer index out of range"));
+        wren::Int32Array other(3);
+        REQUIRE_THROWS_WITH(cls.func("dot(_,_)")(&buffer, &other), Catch::Contains("Buffer sizes do not match"));
+    }
+}
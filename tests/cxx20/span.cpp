@@ -0,0 +1,104 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+static_assert(WRENBIND17_HAS_SPAN, "This file must be compiled with C++20");
+
+class SpanAcceptor {
+public:
+    double sum(std::span<const float> values) {
+        double res = 0.0;
+        for (const auto v : values) {
+            res += v;
+        }
+        return res;
+    }
+
+    void scale(std::span<float> values, float factor) {
+        for (auto& v : values) {
+            v *= factor;
+        }
+    }
+
+    std::span<float> writable() {
+        return std::span<float>(data.data(), data.size());
+    }
+
+    std::span<const float> readonly() {
+        return std::span<const float>(data.data(), data.size());
+    }
+
+    std::vector<float> data = {1.0f, 2.0f, 3.0f};
+};
+
+TEST_CASE("Spans") {
+    const std::string code = R"(
+        import "test" for SpanAcceptor, Float32Array, FloatVector
+
+        class Main {
+            static sum(acceptor) {
+                var buffer = Float32Array.new(3)
+                buffer.fill(1.5)
+                return acceptor.sum(buffer)
+            }
+
+            static scale(acceptor) {
+                acceptor.scale(acceptor.writable(), 2)
+                return acceptor.readonly().sum()
+            }
+
+            static vector(acceptor) {
+                var vector = FloatVector.new()
+                vector.add(1)
+                vector.add(2)
+                acceptor.scale(vector, 10)
+                return acceptor.sum(vector)
+            }
+
+            static modifyReadonly(acceptor) {
+                var buffer = acceptor.readonly()
+                buffer[0] = 5
+            }
+
+            static scaleReadonly(acceptor) {
+                acceptor.scale(acceptor.readonly(), 2)
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    wren::bindBuffers(m);
+    wren::StdVectorBindings<float>::bind(m, "FloatVector");
+    auto& cls = m.klass<SpanAcceptor>("SpanAcceptor");
+    cls.ctor<>();
+    cls.func<&SpanAcceptor::sum>("sum");
+    cls.func<&SpanAcceptor::scale>("scale");
+    cls.func<&SpanAcceptor::writable>("writable");
+    cls.func<&SpanAcceptor::readonly>("readonly");
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+    SpanAcceptor acceptor;
+
+    SECTION("Pop buffer as span") {
+        REQUIRE(main.func("sum(_)")(&acceptor).as<double>() == Approx(4.5));
+    }
+
+    SECTION("Push span without a copy") {
+        REQUIRE(main.func("scale(_)")(&acceptor).as<double>() == Approx(12.0));
+        REQUIRE(acceptor.data == std::vector<float>{2.0f, 4.0f, 6.0f});
+    }
+
+    SECTION("Pop foreign vector as span") {
+        REQUIRE(main.func("vector(_)")(&acceptor).as<double>() == Approx(30.0));
+    }
+
+    SECTION("Read-only span") {
+        REQUIRE_THROWS_WITH(main.func("modifyReadonly(_)")(&acceptor), Catch::Contains("Buffer is read-only"));
+        REQUIRE_THROWS_WITH(main.func("scaleReadonly(_)")(&acceptor), Catch::Contains("read-only"));
+        REQUIRE(acceptor.data == std::vector<float>{1.0f, 2.0f, 3.0f});
+    }
+}
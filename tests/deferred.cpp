@@ -0,0 +1,95 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+static size_t texturesAlive = 0;
+
+class DeferredTexture {
+public:
+    DeferredTexture() {
+        texturesAlive++;
+    }
+
+    ~DeferredTexture() {
+        texturesAlive--;
+    }
+};
+
+TEST_CASE("Deferred release of foreign objects") {
+    const std::string code = R"(
+        import "test" for Texture
+
+        class Main {
+            static create(n) {
+                for (i in 0...n) {
+                    Texture.new()
+                }
+            }
+
+            static keep(texture) {
+                __texture = texture
+            }
+
+            static drop() {
+                __texture = null
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<DeferredTexture>("Texture");
+    cls.ctor<>();
+    cls.deferRelease();
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+    vm.drainReleases();
+
+    SECTION("Destroyed only when drained") {
+        main.func("create(_)")(10);
+        vm.gc();
+        REQUIRE(texturesAlive == 10);
+        REQUIRE(vm.pendingReleases() == 10);
+
+        REQUIRE(vm.drainReleases(4) == 4);
+        REQUIRE(texturesAlive == 6);
+
+        REQUIRE(vm.drainReleases() == 6);
+        REQUIRE(texturesAlive == 0);
+        REQUIRE(vm.pendingReleases() == 0);
+    }
+
+    SECTION("Shared instances are not queued") {
+        auto texture = std::make_shared<DeferredTexture>();
+        main.func("keep(_)")(texture);
+        main.func("drop()")();
+        vm.gc();
+
+        REQUIRE(vm.pendingReleases() == 0);
+        REQUIRE(texturesAlive == 1);
+        texture.reset();
+        REQUIRE(texturesAlive == 0);
+    }
+
+    SECTION("Each VM has its own queue") {
+        {
+            wren::VM other;
+            auto& otherCls = other.module("test").klass<DeferredTexture>("Texture");
+            otherCls.ctor<>();
+            otherCls.deferRelease();
+            other.runFromSource("main", code);
+
+            other.find("main", "Main").func("create(_)")(3);
+            other.gc();
+            REQUIRE(texturesAlive == 3);
+            REQUIRE(other.pendingReleases() == 3);
+            REQUIRE(vm.pendingReleases() == 0);
+            REQUIRE(vm.drainReleases() == 0);
+            REQUIRE(texturesAlive == 3);
+        }
+        // Destroyed together with the VM
+        REQUIRE(texturesAlive == 0);
+    }
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+class PooledEnemy {
+public:
+    int health = 100;
+
+    void damage(int amount) {
+        health -= amount;
+    }
+};
+
+class EnemyPool {
+public:
+    wren::EntityRef<PooledEnemy> spawn() {
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            if (!slots[i].alive) {
+                slots[i].alive = true;
+                slots[i].enemy = PooledEnemy();
+                return wren::EntityRef<PooledEnemy>({this, i, slots[i].generation}, &EnemyPool::resolve);
+            }
+        }
+        slots.emplace_back();
+        slots.back().alive = true;
+        const auto index = static_cast<uint32_t>(slots.size() - 1);
+        return wren::EntityRef<PooledEnemy>({this, index, 0}, &EnemyPool::resolve);
+    }
+
+    void destroy(const wren::EntityRef<PooledEnemy>& entity) {
+        auto& slot = slots.at(entity.getHandle().index);
+        slot.alive = false;
+        slot.generation++;
+    }
+
+    static PooledEnemy* resolve(const wren::EntityHandle& handle) {
+        auto* pool = static_cast<EnemyPool*>(handle.pool);
+        if (handle.index >= pool->slots.size())
+            return nullptr;
+        auto& slot = pool->slots[handle.index];
+        if (!slot.alive || slot.generation != handle.generation)
+            return nullptr;
+        return &slot.enemy;
+    }
+
+private:
+    struct Slot {
+        PooledEnemy enemy;
+        uint32_t generation{0};
+        bool alive{false};
+    };
+
+    std::vector<Slot> slots;
+};
+
+TEST_CASE("Generation checked entity handles") {
+    const std::string code = R"(
+        import "test" for Enemy
+
+        class Main {
+            static hit(enemy) {
+                enemy.damage(10)
+                return enemy.health
+            }
+
+            static store(enemy) {
+                __enemy = enemy
+            }
+
+            static hitStored() {
+                return hit(__enemy)
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<PooledEnemy>("Enemy");
+    cls.func<&PooledEnemy::damage>("damage");
+    cls.var<&PooledEnemy::health>("health");
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    EnemyPool pool;
+    auto enemy = pool.spawn();
+
+    SECTION("Resolved on each use") {
+        REQUIRE(main.func("hit(_)")(enemy).as<int>() == 90);
+        REQUIRE(enemy.get()->health == 90);
+        REQUIRE(main.func("hit(_)")(enemy).as<int>() == 80);
+    }
+
+    SECTION("Stored in Wren") {
+        main.func("store(_)")(enemy);
+        REQUIRE(main.func("hitStored()")().as<int>() == 90);
+        REQUIRE(main.func("hitStored()")().as<int>() == 80);
+    }
+
+    SECTION("Stale handle raises a runtime error") {
+        main.func("store(_)")(enemy);
+        pool.destroy(enemy);
+        REQUIRE_FALSE(enemy);
+
+        // The slot is reused with a new generation
+        auto other = pool.spawn();
+        REQUIRE(other.getHandle().index == enemy.getHandle().index);
+
+        REQUIRE_THROWS_WITH(main.func("hitStored()")(), Catch::Contains("Entity handle is stale"));
+        REQUIRE(other.get()->health == 100);
+    }
+}
+
+TEST_CASE("Pop entity handle from Wren") {
+    const std::string code = R"(
+        class Main {
+            static identity(enemy) {
+                return enemy
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<PooledEnemy>("Enemy");
+    cls.var<&PooledEnemy::health>("health");
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main").func("identity(_)");
+
+    EnemyPool pool;
+    auto enemy = pool.spawn();
+
+    auto res = main(enemy);
+    REQUIRE(res.is<PooledEnemy>());
+    REQUIRE(res.as<PooledEnemy*>() == enemy.get());
+    REQUIRE(res.as<wren::EntityRef<PooledEnemy>>().getHandle().generation == enemy.getHandle().generation);
+    REQUIRE_THROWS_AS(res.shared<PooledEnemy>(), wren::BadCast);
+
+    pool.destroy(enemy);
+    REQUIRE_THROWS_WITH(res.as<PooledEnemy*>(), Catch::Contains("Entity handle is stale"));
+}
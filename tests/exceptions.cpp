@@ -616,3 +616,74 @@ TEST_CASE("Push unregistered class") {
 
     REQUIRE_THROWS_AS(main(ExceptionClass()), wren::BadCast);
 }
+
+class TypedArgs {
+public:
+    float add(float a, float b) noexcept {
+        return a + b;
+    }
+
+    std::string concat(const std::string& a, int b) const {
+        return a + std::to_string(b);
+    }
+
+    static double twice(double v) noexcept {
+        return v * 2.0;
+    }
+};
+
+TEST_CASE("Wrong argument type aborts the fiber") {
+    const std::string code = R"(
+        import "test" for TypedArgs
+
+        var T = TypedArgs.new()
+
+        class Main {
+            static add(a, b) {
+                return T.add(a, b)
+            }
+
+            static concat(a, b) {
+                return T.concat(a, b)
+            }
+
+            static twice(v) {
+                return TypedArgs.twice(v)
+            }
+
+            static probe(n) {
+                var failed = 0
+                for (i in 0...n) {
+                    var fiber = Fiber.new { T.add(i, "not a number") }
+                    fiber.try()
+                    if (fiber.error != null) failed = failed + 1
+                }
+                return failed
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<TypedArgs>("TypedArgs");
+    cls.ctor<>();
+    cls.func<&TypedArgs::add>("add");
+    cls.func<&TypedArgs::concat>("concat");
+    cls.funcStatic<&TypedArgs::twice>("twice");
+    vm.runFromSource("main", code);
+
+    auto main = vm.find("main", "Main");
+
+    REQUIRE(main.func("add(_,_)")(1.5, 2.0).as<float>() == Approx(3.5f));
+    REQUIRE(main.func("concat(_,_)")(std::string("a"), 1).as<std::string>() == "a1");
+    REQUIRE(main.func("twice(_)")(4.0).as<double>() == Approx(8.0));
+
+    REQUIRE_THROWS_WITH(main.func("add(_,_)")(1.5, std::string("x")),
+                        Catch::Contains("Bad cast when getting value from Wren got string expected number"));
+    REQUIRE_THROWS_WITH(main.func("concat(_,_)")(1, 1),
+                        Catch::Contains("Bad cast when getting value from Wren got number expected string"));
+    REQUIRE_THROWS_WITH(main.func("twice(_)")(nullptr),
+                        Catch::Contains("Bad cast when getting value from Wren got null expected number"));
+
+    REQUIRE(main.func("probe(_)")(100).as<int>() == 100);
+}
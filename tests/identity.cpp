@@ -0,0 +1,220 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+class IdentityPlayer {
+public:
+    int health = 100;
+};
+
+class IdentityWorld {
+public:
+    IdentityWorld() : shared(std::make_shared<IdentityPlayer>()) {
+    }
+
+    IdentityPlayer* getPlayer() {
+        return &player;
+    }
+
+    IdentityPlayer& getPlayerRef() {
+        return player;
+    }
+
+    std::shared_ptr<IdentityPlayer> getShared() {
+        return shared;
+    }
+
+    IdentityPlayer player;
+    std::shared_ptr<IdentityPlayer> shared;
+};
+
+TEST_CASE("Identity of pushed instances") {
+    const std::string code = R"(
+        import "test" for IdentityWorld, IdentityPlayer
+
+        class Main {
+            static same(world) {
+                return world.getPlayer() == world.getPlayer() &&
+                    world.getPlayer() == world.getPlayerRef() &&
+                    world.getShared() == world.getShared()
+            }
+
+            static different(world) {
+                return world.getPlayer() == world.getShared()
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& world = m.klass<IdentityWorld>("IdentityWorld");
+    world.func<&IdentityWorld::getPlayer>("getPlayer");
+    world.func<&IdentityWorld::getPlayerRef>("getPlayerRef");
+    world.func<&IdentityWorld::getShared>("getShared");
+
+    auto& player = m.klass<IdentityPlayer>("IdentityPlayer");
+    player.var<&IdentityPlayer::health>("health");
+
+    IdentityWorld instance;
+
+    SECTION("Enabled") {
+        player.identity();
+        vm.runFromSource("main", code);
+        auto main = vm.find("main", "Main");
+
+        REQUIRE(main.func("same(_)")(&instance).as<bool>() == true);
+        REQUIRE(main.func("different(_)")(&instance).as<bool>() == false);
+
+        REQUIRE(vm.releaseIdentity(&instance.player) == true);
+        REQUIRE(vm.releaseIdentity(&instance.player) == false);
+        REQUIRE(vm.releaseIdentity(instance.shared.get()) == true);
+
+        vm.releaseIdentities();
+        vm.gc();
+        REQUIRE(main.func("same(_)")(&instance).as<bool>() == true);
+    }
+
+    SECTION("Disabled") {
+        vm.runFromSource("main", code);
+        auto main = vm.find("main", "Main");
+
+        REQUIRE(main.func("same(_)")(&instance).as<bool>() == false);
+        REQUIRE(vm.releaseIdentity(&instance.player) == false);
+    }
+}
+
+TEST_CASE("Identity does not keep shared instances alive") {
+    const std::string code = R"(
+        import "test" for IdentityPlayer
+
+        class Main {
+            static same(a, b) {
+                return a == b
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& player = m.klass<IdentityPlayer>("IdentityPlayer");
+    player.var<&IdentityPlayer::health>("health");
+    player.identity();
+
+    vm.runFromSource("main", code);
+    auto same = vm.find("main", "Main").func("same(_,_)");
+
+    auto shared = std::make_shared<IdentityPlayer>();
+    std::weak_ptr<IdentityPlayer> weak = shared;
+    auto* ptr = shared.get();
+
+    // The borrowed Wren object is not reused for the shared pointer
+    REQUIRE(same(ptr, shared).as<bool>() == false);
+    REQUIRE(same(shared, shared).as<bool>() == true);
+    REQUIRE(same(ptr, ptr).as<bool>() == true);
+
+    SECTION("Released when C++ drops the owner") {
+        shared.reset();
+        vm.gc();
+        REQUIRE(weak.expired());
+
+        // The borrowed object is still remembered until it is released
+        REQUIRE(vm.releaseIdentity(ptr) == true);
+        REQUIRE(vm.releaseIdentity(ptr) == false);
+    }
+
+    SECTION("Kept while C++ owns the instance") {
+        vm.gc();
+        REQUIRE(!weak.expired());
+        REQUIRE(same(shared, shared).as<bool>() == true);
+    }
+}
+
+TEST_CASE("Identity of borrowed instances is bounded") {
+    const std::string code = R"(
+        import "test" for IdentityPlayer
+
+        class Main {
+            static same(a, b) {
+                return a == b
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& player = m.klass<IdentityPlayer>("IdentityPlayer");
+    player.var<&IdentityPlayer::health>("health");
+
+    IdentityPlayer players[3];
+
+    SECTION("Least recently pushed are forgotten") {
+        player.identity(2);
+        vm.runFromSource("main", code);
+        auto same = vm.find("main", "Main").func("same(_,_)");
+
+        REQUIRE(same(&players[0], &players[0]).as<bool>() == true);
+        REQUIRE(same(&players[1], &players[1]).as<bool>() == true);
+        // Pushing players[0] again makes players[1] the least recently pushed one
+        REQUIRE(same(&players[0], &players[0]).as<bool>() == true);
+        REQUIRE(same(&players[2], &players[2]).as<bool>() == true);
+
+        REQUIRE(vm.releaseIdentity(&players[1]) == false);
+        REQUIRE(vm.releaseIdentity(&players[0]) == true);
+        REQUIRE(vm.releaseIdentity(&players[2]) == true);
+    }
+
+    SECTION("Zero remembers only shared instances") {
+        player.identity(0);
+        vm.runFromSource("main", code);
+        auto same = vm.find("main", "Main").func("same(_,_)");
+
+        auto shared = std::make_shared<IdentityPlayer>();
+        REQUIRE(same(&players[0], &players[0]).as<bool>() == false);
+        REQUIRE(same(shared, shared).as<bool>() == true);
+        REQUIRE(vm.releaseIdentity(&players[0]) == false);
+    }
+}
+
+TEST_CASE("Identity of shared instances taken back from Wren") {
+    const std::string code = R"(
+        import "test" for IdentityPlayer
+
+        class Main {
+            static keep(player) {
+                __kept = player
+            }
+
+            static kept {
+                return __kept
+            }
+
+            static isKept(player) {
+                return player == __kept
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& player = m.klass<IdentityPlayer>("IdentityPlayer");
+    player.var<&IdentityPlayer::health>("health");
+    player.identity();
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    auto shared = std::make_shared<IdentityPlayer>();
+    std::weak_ptr<IdentityPlayer> weak = shared;
+    main.func("keep(_)")(shared);
+
+    // Only Wren owns the instance now, so its Wren object is forgotten
+    shared.reset();
+    vm.gc();
+    REQUIRE(!weak.expired());
+
+    // Getting it back from Wren remembers the same Wren object again
+    shared = main.func("kept")().shared<IdentityPlayer>();
+    REQUIRE(shared.get() == weak.lock().get());
+    REQUIRE(main.func("isKept(_)")(shared).as<bool>() == true);
+}
@@ -1,4 +1,5 @@
 #include <catch2/catch.hpp>
+#include <numeric>
 #include <wrenbind17/wrenbind17.hpp>
 
 namespace wren = wrenbind17;
@@ -425,3 +426,347 @@ TEST_CASE("Get native lists as vector") {
     REQUIRE(std::get<bool>(vec[2]) == true);
     REQUIRE(std::get<std::string>(vec[3]) == "Hello World");
 }
+
+TEST_CASE("Native list handle") {
+    const std::string code = R"(
+        class Main {
+            static main() {
+                return [1, 2, 3, "Hello"]
+            }
+
+            static join(list) {
+                return list.join(",")
+            }
+        }
+    )";
+
+    wren::VM vm;
+
+    vm.runFromSource("main", code);
+    auto join = vm.find("main", "Main").func("join(_)");
+
+    SECTION("Get from Wren") {
+        auto res = vm.find("main", "Main").func("main()")();
+        REQUIRE(res.is<wren::List>());
+        auto list = res.as<wren::List>();
+
+        REQUIRE(list.count() == 4);
+        REQUIRE(list.get<int>(0) == 1);
+        REQUIRE(list.get<std::string>(3) == "Hello");
+        REQUIRE_THROWS_AS(list.get<int>(4), std::out_of_range);
+        REQUIRE_THROWS_AS(list.get<int>(3), wren::BadCast);
+
+        list.set(3, 4);
+        list.insert(0, 0);
+        list.append(std::string("end"));
+        REQUIRE(join(list).as<std::string>() == "0,1,2,3,4,end");
+
+        list.removeAt(5);
+        list.removeAt(0);
+        REQUIRE(join(list).as<std::string>() == "1,2,3,4");
+        REQUIRE_THROWS_AS(list.removeAt(4), std::out_of_range);
+    }
+
+    SECTION("Bulk operations") {
+        auto list = vm.createList();
+        REQUIRE(list.count() == 0);
+
+        std::vector<int> values = {1, 2, 3};
+        list.appendRange(values.begin(), values.end());
+        list.appendRange(values.begin(), values.end());
+        REQUIRE(list.count() == 6);
+        REQUIRE(join(list).as<std::string>() == "1,2,3,1,2,3");
+
+        std::array<double, 4> out{};
+        REQUIRE(list.copyTo(out) == 4);
+        REQUIRE(out == std::array<double, 4>{1.0, 2.0, 3.0, 1.0});
+
+        std::vector<std::string> strings(2);
+        auto other = vm.createList();
+        other.append(std::string("Hello"));
+        REQUIRE(other.copyTo(strings) == 1);
+        REQUIRE(strings[0] == "Hello");
+    }
+}
+
+class NumberListAcceptor {
+public:
+    double sum(const std::vector<double>& values) {
+        return std::accumulate(values.begin(), values.end(), 0.0);
+    }
+
+    std::vector<int> range(int count) {
+        std::vector<int> res(count);
+        std::iota(res.begin(), res.end(), 0);
+        return res;
+    }
+
+    void set(std::vector<float> values) {
+        floats = std::move(values);
+    }
+
+    std::string join(const std::vector<std::string>& values, const std::string& separator) {
+        std::string res;
+        for (const auto& value : values) {
+            if (!res.empty())
+                res += separator;
+            res += value;
+        }
+        return res;
+    }
+
+    std::vector<float> floats;
+};
+
+TEST_CASE("Native lists of numbers") {
+    const std::string code = R"(
+        import "test" for NumberListAcceptor
+
+        class Main {
+            static sum(acceptor) {
+                return acceptor.sum([1.5, 2.5, 3.0])
+            }
+
+            static range(acceptor) {
+                var res = acceptor.range(1000)
+                return res[0] + res[999] + res.count
+            }
+
+            static set(acceptor) {
+                acceptor.set([0.5, 1, -2])
+            }
+
+            static bad(acceptor) {
+                return acceptor.sum([1.5, "Hello World"])
+            }
+
+            static list() {
+                return [1, 2.5, 3]
+            }
+
+            static join(acceptor) {
+                return acceptor.join(["a", "b", "c"], ", ")
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<NumberListAcceptor>("NumberListAcceptor");
+    cls.ctor<>();
+    cls.func<&NumberListAcceptor::sum>("sum");
+    cls.func<&NumberListAcceptor::range>("range");
+    cls.func<&NumberListAcceptor::set>("set");
+    cls.func<&NumberListAcceptor::join>("join");
+
+    vm.runFromSource("main", code);
+
+    NumberListAcceptor instance;
+
+    SECTION("Pop list of doubles") {
+        auto res = vm.find("main", "Main").func("sum(_)")(&instance);
+        REQUIRE(res.as<double>() == Approx(7.0));
+    }
+
+    SECTION("Push vector of ints") {
+        auto res = vm.find("main", "Main").func("range(_)")(&instance);
+        REQUIRE(res.as<int>() == 1999);
+    }
+
+    SECTION("Pop list of floats") {
+        (void)vm.find("main", "Main").func("set(_)")(&instance);
+        REQUIRE(instance.floats == std::vector<float>{0.5f, 1.0f, -2.0f});
+    }
+
+    SECTION("Pop list with a bad element") {
+        REQUIRE_THROWS_WITH(vm.find("main", "Main").func("bad(_)")(&instance),
+                            Catch::Contains("Bad cast when getting value from Wren got string expected number"));
+    }
+
+    SECTION("Get native list as vector of doubles") {
+        auto res = vm.find("main", "Main").func("list()")();
+        REQUIRE(res.isList());
+        REQUIRE(res.as<std::vector<double>>() == std::vector<double>{1.0, 2.5, 3.0});
+    }
+
+    SECTION("Pop list of strings followed by another argument") {
+        auto res = vm.find("main", "Main").func("join(_)")(&instance);
+        REQUIRE(res.as<std::string>() == "a, b, c");
+    }
+}
+
+class FixedListAcceptor {
+public:
+    float brightness(const std::array<float, 4>& rgba) {
+        return (rgba[0] + rgba[1] + rgba[2]) * rgba[3];
+    }
+
+    std::array<int, 3> triple(int value) {
+        return {value, value * 2, value * 3};
+    }
+
+    std::string describe(std::tuple<std::string, int, bool> value) {
+        return std::get<0>(value) + ":" + std::to_string(std::get<1>(value)) + (std::get<2>(value) ? "!" : "");
+    }
+
+    std::pair<std::string, double> pair() {
+        return {"pi", 3.5};
+    }
+
+    int names(const std::array<std::string, 2>& value) {
+        return static_cast<int>(value[0].size() + value[1].size());
+    }
+};
+
+TEST_CASE("Native lists of fixed size") {
+    const std::string code = R"(
+        import "test" for FixedListAcceptor
+
+        class Main {
+            static brightness(acceptor) {
+                return acceptor.brightness([0.25, 0.5, 0.25, 2])
+            }
+
+            static triple(acceptor) {
+                var res = acceptor.triple(5)
+                return res[0] + res[1] + res[2] + res.count
+            }
+
+            static describe(acceptor) {
+                return acceptor.describe(["Hello", 42, true])
+            }
+
+            static pair(acceptor) {
+                var res = acceptor.pair()
+                return res[0] + "=" + res[1].toString
+            }
+
+            static names(acceptor) {
+                return acceptor.names(["Hello", "World!"])
+            }
+
+            static list() {
+                return [1, 2, 3]
+            }
+
+            static badSize(acceptor) {
+                return acceptor.brightness([1, 2, 3])
+            }
+
+            static badTuple(acceptor) {
+                return acceptor.describe(["Hello", "World", true])
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<FixedListAcceptor>("FixedListAcceptor");
+    cls.ctor<>();
+    cls.func<&FixedListAcceptor::brightness>("brightness");
+    cls.func<&FixedListAcceptor::triple>("triple");
+    cls.func<&FixedListAcceptor::describe>("describe");
+    cls.func<&FixedListAcceptor::pair>("pair");
+    cls.func<&FixedListAcceptor::names>("names");
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    FixedListAcceptor instance;
+
+    SECTION("std::array") {
+        REQUIRE(main.func("brightness(_)")(&instance).as<double>() == Approx(2.0));
+        REQUIRE(main.func("triple(_)")(&instance).as<int>() == 33);
+        REQUIRE(main.func("names(_)")(&instance).as<int>() == 11);
+    }
+
+    SECTION("std::tuple and std::pair") {
+        REQUIRE(main.func("describe(_)")(&instance).as<std::string>() == "Hello:42!");
+        REQUIRE(main.func("pair(_)")(&instance).as<std::string>() == "pi=3.5");
+    }
+
+    SECTION("Get native list as array or tuple") {
+        auto res = main.func("list()")();
+        REQUIRE(res.as<std::array<int, 3>>() == std::array<int, 3>{1, 2, 3});
+        REQUIRE(res.as<std::tuple<int, double, int>>() == std::tuple<int, double, int>{1, 2.0, 3});
+    }
+
+    SECTION("Wrong size") {
+        REQUIRE_THROWS_WITH(main.func("badSize(_)")(&instance),
+                            Catch::Contains("Bad cast when getting value from Wren expected list of size 4"));
+        REQUIRE_THROWS_WITH(main.func("badTuple(_)")(&instance),
+                            Catch::Contains("Bad cast when getting value from Wren got string expected number"));
+    }
+}
+
+class ListViewAcceptor {
+public:
+    int find(const wren::ListView<std::string>& list, const std::string& needle) {
+        for (size_t i = 0; i < list.size(); i++) {
+            if (list[i] == needle)
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    double sum(wren::ListView<double> list) {
+        double res = 0.0;
+        for (const auto value : list) {
+            res += value;
+        }
+        return res;
+    }
+
+    int at(wren::ListView<int> list, size_t index) {
+        return list.at(index);
+    }
+};
+
+TEST_CASE("List views") {
+    const std::string code = R"(
+        import "test" for ListViewAcceptor
+
+        class Main {
+            static find(acceptor) {
+                // The search stops before the bad element
+                return acceptor.find(["a", "b", "c", 42], "c")
+            }
+
+            static sum(acceptor) {
+                return acceptor.sum([1.5, 2.5, 3.0])
+            }
+
+            static at(acceptor, index) {
+                return acceptor.at([1, 2, "3"], index)
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<ListViewAcceptor>("ListViewAcceptor");
+    cls.ctor<>();
+    cls.func<&ListViewAcceptor::find>("find");
+    cls.func<&ListViewAcceptor::sum>("sum");
+    cls.func<&ListViewAcceptor::at>("at");
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    ListViewAcceptor instance;
+
+    SECTION("Random access") {
+        REQUIRE(main.func("find(_)")(&instance).as<int>() == 2);
+        REQUIRE(main.func("at(_,_)")(&instance, 1).as<int>() == 2);
+    }
+
+    SECTION("Range for") {
+        REQUIRE(main.func("sum(_)")(&instance).as<double>() == Approx(7.0));
+    }
+
+    SECTION("Errors") {
+        REQUIRE_THROWS_WITH(main.func("at(_,_)")(&instance, 3), Catch::Contains("ListView index out of range"));
+        REQUIRE_THROWS_WITH(main.func("at(_,_)")(&instance, 2),
+                            Catch::Contains("Bad cast when getting value from Wren got string expected number"));
+    }
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+namespace wren = wrenbind17;
+
+TEST_CASE("Memory mapped files") {
+    const std::string path = "wrenbind17_mapped_test.bin";
+    {
+        const int32_t ints[] = {10, -20, 30};
+        const double values[] = {1.5, 2.5};
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(ints), sizeof(ints));
+        file.write("\0\0\0\0", 4);
+        file.write(reinterpret_cast<const char*>(values), sizeof(values));
+    }
+
+    const std::string code = R"(
+        import "test" for MappedFile, ByteArray, Int32Array, Float64Array
+
+        class Main {
+            static read(file) {
+                return file.readInt32(4) + file.readFloat64(16) + file.count
+            }
+
+            static sum(file) {
+                return file.int32View(0, 3).sum()
+            }
+
+            static values(file) {
+                return file.float64View(16, 2).toList()
+            }
+
+            static modify(file) {
+                file.bytes(0, 4)[0] = 1
+            }
+
+            static outOfRange(file) {
+                return file.readFloat64(file.count - 4)
+            }
+
+            static open(path) {
+                return MappedFile.open(path)
+            }
+        }
+    )";
+
+    SECTION("Shared by the process") {
+        auto a = wren::MappedFile::open(path);
+        auto b = wren::MappedFile::open("./" + path);
+        REQUIRE(a.get() == b.get());
+        REQUIRE(a->size() == 32);
+        REQUIRE(a->read<int32_t>(8) == 30);
+        REQUIRE_THROWS_AS(a->read<int32_t>(30), std::out_of_range);
+
+        auto view = a->view<int32_t>(0, 3);
+        REQUIRE(view.isReadonly());
+        a.reset();
+        b.reset();
+        REQUIRE(std::as_const(view)[1] == -20);
+    }
+
+    SECTION("Read from Wren") {
+        wren::VM vm;
+        auto& m = vm.module("test");
+        wren::bindBuffers(m);
+        wren::MappedFileBindings::bind(m, "MappedFile");
+
+        vm.runFromSource("main", code);
+        auto cls = vm.find("main", "Main");
+        auto file = wren::MappedFile::open(path);
+
+        REQUIRE(cls.func("read(_)")(file).as<double>() == Approx(-20 + 2.5 + 32));
+        REQUIRE(cls.func("sum(_)")(file).as<int>() == 20);
+        REQUIRE(cls.func("values(_)")(file).as<std::vector<double>>() == std::vector<double>{1.5, 2.5});
+        REQUIRE_THROWS_WITH(cls.func("modify(_)")(file), Catch::Contains("Buffer is read-only"));
+        REQUIRE_THROWS_WITH(cls.func("outOfRange(_)")(file), Catch::Contains("MappedFile offset out of range"));
+        REQUIRE_THROWS_WITH(cls.func("open(_)")(path), Catch::Contains("does not implement 'open(_)'"));
+    }
+
+    std::remove(path.c_str());
+}
@@ -461,3 +461,267 @@ TEST_CASE("Get map of ints to Wren as native") {
 
     REQUIRE(res.is<std::string>());
 }
+
+class MapAcceptor {
+public:
+    int sum(const std::unordered_map<std::string, int>& map) {
+        int res = 0;
+        for (const auto& pair : map) {
+            res += pair.second;
+        }
+        return res;
+    }
+
+    std::string join(std::map<int, std::string> map) {
+        std::string res;
+        for (const auto& pair : map) {
+            res += pair.second;
+        }
+        return res;
+    }
+
+    int nested(const std::map<std::string, std::map<std::string, int>>& map) {
+        int res = 0;
+        for (const auto& pair : map) {
+            for (const auto& inner : pair.second) {
+                res += inner.second;
+            }
+        }
+        return res;
+    }
+
+    static size_t count(const int extra, std::unordered_map<std::string, bool> map) {
+        return map.size() + extra;
+    }
+
+    static size_t anySize(wren::Any value) {
+        return value.as<std::map<std::string, int>>().size();
+    }
+
+    std::map<int, double> squares(int count) {
+        std::map<int, double> res;
+        for (auto i = 0; i < count; i++) {
+            res[i] = i * i;
+        }
+        return res;
+    }
+};
+
+class MapHolder {
+public:
+    explicit MapHolder(std::map<std::string, int> map) : map(std::move(map)) {
+    }
+
+    std::map<std::string, int> map;
+};
+
+TEST_CASE("Pop map from Wren") {
+    const std::string code = R"(
+        import "test" for MapAcceptor, MapHolder, MapStringInt
+        import "wrenbind17:maps" for MapEntries
+
+        class Main {
+            static sum(acceptor) {
+                return acceptor.sum(MapEntries.of({"first": 1, "second": 2, "third": 3}))
+            }
+
+            static join(acceptor) {
+                return acceptor.join(MapEntries.of({2: "World", 0: "Hello", 1: " "}))
+            }
+
+            static squares(acceptor) {
+                var res = acceptor.squares(4)
+                return res[0] + res[1] + res[2] + res[3]
+            }
+
+            static foreign(acceptor) {
+                var map = MapStringInt.new()
+                map["first"] = 10
+                map["second"] = 20
+                return acceptor.sum(map)
+            }
+
+            static bad(acceptor) {
+                return acceptor.sum(MapEntries.of({"first": "Hello"}))
+            }
+
+            static native(acceptor) {
+                return acceptor.sum({"first": 1})
+            }
+
+            static list(acceptor) {
+                return acceptor.sum([["first", "second"], [1, 2]])
+            }
+
+            static nested(acceptor) {
+                var a = MapEntries.of({"x": 1, "y": 2})
+                var b = MapEntries.of({"z": 3})
+                return acceptor.nested(MapEntries.of({"a": a, "b": b, "c": MapEntries.of({})}))
+            }
+
+            static count() {
+                return MapAcceptor.count(10, MapEntries.of({"a": true, "b": false}))
+            }
+
+            static holder() {
+                return MapHolder.new(MapEntries.of({"first": 1, "second": 2}))
+            }
+
+            static anySize() {
+                return MapAcceptor.anySize({"first": 1})
+            }
+
+            static native() {
+                return {"first": 1, "second": 2, "third": 3}
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    wren::StdUnorderedMapBindings<std::string, int>::bind(m, "MapStringInt");
+    auto& cls = m.klass<MapAcceptor>("MapAcceptor");
+    cls.ctor<>();
+    cls.func<&MapAcceptor::sum>("sum");
+    cls.func<&MapAcceptor::join>("join");
+    cls.func<&MapAcceptor::squares>("squares");
+    cls.func<&MapAcceptor::nested>("nested");
+    cls.funcStatic<&MapAcceptor::count>("count");
+    cls.funcStatic<&MapAcceptor::anySize>("anySize");
+    auto& holder = m.klass<MapHolder>("MapHolder");
+    holder.ctor<std::map<std::string, int>>();
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    MapAcceptor instance;
+
+    SECTION("Push map with number keys") {
+        REQUIRE(main.func("squares(_)")(&instance).as<int>() == 14);
+    }
+
+    SECTION("Pop foreign map") {
+        REQUIRE(main.func("foreign(_)")(&instance).as<int>() == 30);
+    }
+
+    SECTION("Methods with maps are not wrapped") {
+        const auto code = m.str();
+        REQUIRE_THAT(code, Catch::Contains("foreign sum(arg0)"));
+        REQUIRE_THAT(code, !Catch::Contains("wrenbind17"));
+    }
+
+    SECTION("Pop native map") {
+        REQUIRE(main.func("sum(_)")(&instance).as<int>() == 6);
+        REQUIRE(main.func("join(_)")(&instance).as<std::string>() == "Hello World");
+        REQUIRE_THROWS_WITH(main.func("bad(_)")(&instance),
+                            Catch::Contains("Bad cast when getting value from Wren got string expected number"));
+    }
+
+    SECTION("Native maps and plain lists are rejected") {
+        REQUIRE_THROWS_WITH(main.func("native(_)")(&instance), Catch::Contains("MapEntries.of(map)"));
+        REQUIRE_THROWS_WITH(main.func("list(_)")(&instance), Catch::Contains("expected map"));
+    }
+
+    SECTION("Pop nested native map") {
+        REQUIRE(main.func("nested(_)")(&instance).as<int>() == 6);
+    }
+
+    SECTION("Pop native map into static function") {
+        REQUIRE(main.func("count()")().as<int>() == 12);
+    }
+
+    SECTION("Pop native map into constructor") {
+        auto res = main.func("holder()")().shared<MapHolder>();
+        REQUIRE(res->map.size() == 2);
+        REQUIRE(res->map.at("second") == 2);
+    }
+
+    SECTION("Get native map as std map") {
+        auto res = main.func("native()")();
+        REQUIRE(res.isMap());
+        const auto map = res.as<std::map<std::string, int>>();
+        REQUIRE(map.size() == 3);
+        REQUIRE(map.at("first") == 1);
+        REQUIRE(map.at("third") == 3);
+
+        const auto other = res.as<std::unordered_map<std::string, double>>();
+        REQUIRE(other.at("second") == Approx(2.0));
+        using StringMap = std::map<std::string, std::string>;
+        REQUIRE_THROWS_AS(res.as<StringMap>(), wren::BadCast);
+    }
+
+    SECTION("Get native map as std map while Wren is running") {
+        REQUIRE_THROWS_WITH(main.func("anySize()")(), Catch::Contains("while Wren is running"));
+    }
+
+    SECTION("Reserved module names") {
+        REQUIRE_THROWS_AS(vm.module("wrenbind17:maps"), wren::Exception);
+        REQUIRE_THROWS_AS(vm.lazyModule("wrenbind17:other", [](wren::ForeignModule&) {}), wren::Exception);
+    }
+}
+
+TEST_CASE("Native map read and write") {
+    const std::string code = R"(
+        class Main {
+            static main() {
+                return {
+                    "width": 800,
+                    "height": 600,
+                    "title": "Hello World",
+                    "parent": null
+                }
+            }
+
+            static other(map) {
+                return map["fullscreen"]
+            }
+        }
+    )";
+
+    wren::VM vm;
+
+    vm.runFromSource("main", code);
+    auto map = vm.find("main", "Main").func("main()")().as<wren::Map>();
+
+    SECTION("Try get") {
+        REQUIRE(map.tryGet<int>(std::string("width")) == std::optional<int>(800));
+        REQUIRE(map.tryGet<int>(std::string("depth")) == std::nullopt);
+        REQUIRE(map.tryGet<std::nullptr_t>(std::string("parent")) == std::optional<std::nullptr_t>(nullptr));
+        REQUIRE(map.get<std::nullptr_t>(std::string("parent")) == nullptr);
+        REQUIRE_THROWS_AS(map.get<int>(std::string("depth")), wren::NotFound);
+    }
+
+    SECTION("Set") {
+        map.set(std::string("fullscreen"), true);
+        map.set(std::string("width"), 1024);
+        REQUIRE(map.count() == 5);
+        REQUIRE(map.get<int>(std::string("width")) == 1024);
+
+        auto res = vm.find("main", "Main").func("other(_)")(map);
+        REQUIRE(res.as<bool>() == true);
+    }
+
+    SECTION("Get many") {
+        std::vector<std::string> keys = {"width", "height", "depth"};
+        std::unordered_map<std::string, int> out;
+        REQUIRE(map.getMany(keys, out) == 2);
+        REQUIRE(out.size() == 2);
+        REQUIRE(out.at("width") == 800);
+        REQUIRE(out.at("height") == 600);
+
+        std::vector<std::string> bad = {"title"};
+        REQUIRE_THROWS_AS(map.getMany(bad, out), wren::BadCast);
+    }
+
+    SECTION("Set many") {
+        std::map<std::string, int> values = {{"x", 10}, {"y", 20}};
+        map.setMany(values);
+
+        std::vector<std::pair<std::string, std::string>> strings = {{"title", "Other"}};
+        map.setMany(strings);
+
+        REQUIRE(map.count() == 6);
+        REQUIRE(map.get<int>(std::string("y")) == 20);
+        REQUIRE(map.get<std::string>(std::string("title")) == "Other");
+    }
+}
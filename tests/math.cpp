@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+TEST_CASE("Math types") {
+    const std::string code = R"(
+        import "test" for Vec3, Vec4, Quat, Mat4, Float32Array
+
+        class Main {
+            static vectors() {
+                var a = Vec3.new(1, 2, 3)
+                var b = Vec3.new(4, 5, 6)
+                return (a + b) * 2 - a
+            }
+
+            static compound(n) {
+                var a = Vec3.new(0, 0, 0)
+                var step = Vec3.new(1, 0.5, 0)
+                for (i in 0...n) {
+                    a.addAssign(step)
+                }
+                a.mulAssign(2)
+                return a
+            }
+
+            static cross(a, b) {
+                return a.cross(b)
+            }
+
+            static rotate(angle) {
+                var q = Quat.fromAxisAngle(Vec3.new(0, 0, 1), angle)
+                return q.rotate(Vec3.new(1, 0, 0))
+            }
+
+            static transform(m, v) {
+                return m.transform(v)
+            }
+
+            static matrix() {
+                var m = Mat4.translation(Vec3.new(1, 2, 3)) * Mat4.scaling(Vec3.new(2, 2, 2))
+                return m.transformPoint(Vec3.new(1, 1, 1))
+            }
+
+            static batch(m, buffer) {
+                m.transformPoints(buffer)
+            }
+
+            static equal(a, b) {
+                return a == b
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    wren::bindMath(m);
+    wren::bindBuffers(m);
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    SECTION("Vector operators") {
+        auto res = main.func("vectors()")();
+        REQUIRE(res.is<wren::Vec3>());
+        REQUIRE(res.as<wren::Vec3>() == wren::Vec3(9.0f, 12.0f, 15.0f));
+
+        auto cross = main.func("cross(_,_)")(wren::Vec3(1, 0, 0), wren::Vec3(0, 1, 0)).as<wren::Vec3>();
+        REQUIRE(cross == wren::Vec3(0.0f, 0.0f, 1.0f));
+
+        REQUIRE(main.func("equal(_,_)")(wren::Vec3(1, 2, 3), wren::Vec3(1, 2, 3)).as<bool>());
+        REQUIRE_FALSE(main.func("equal(_,_)")(wren::Vec3(1, 2, 3), wren::Vec3(1, 2, 4)).as<bool>());
+    }
+
+    SECTION("Compound operators") {
+        auto res = main.func("compound(_)")(10).as<wren::Vec3>();
+        REQUIRE(res.x == Approx(20.0f));
+        REQUIRE(res.y == Approx(10.0f));
+        REQUIRE(res.z == Approx(0.0f));
+    }
+
+    SECTION("Stored inline") {
+        auto res = main.func("vectors()")();
+        REQUIRE(res.as<wren::Vec3*>() != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(res.as<wren::Vec3*>()) % alignof(wren::Vec3) == 0);
+        REQUIRE_THROWS_AS(res.shared<wren::Vec3>(), wren::BadCast);
+    }
+
+    SECTION("Quaternion and matrix") {
+        auto rotated = main.func("rotate(_)")(3.14159265 / 2.0).as<wren::Vec3>();
+        REQUIRE(rotated.x == Approx(0.0f).margin(1e-6));
+        REQUIRE(rotated.y == Approx(1.0f));
+
+        auto point = main.func("matrix()")().as<wren::Vec3>();
+        REQUIRE(point == wren::Vec3(3.0f, 4.0f, 5.0f));
+
+        auto v = main.func("transform(_,_)")(wren::Mat4::scaling(wren::Vec3(2, 3, 4)), wren::Vec4(1, 1, 1, 1));
+        REQUIRE(v.as<wren::Vec4>() == wren::Vec4(2.0f, 3.0f, 4.0f, 1.0f));
+    }
+
+    SECTION("Batch transform over a buffer") {
+        std::vector<float> points = {1.0f, 2.0f, 3.0f, -1.0f, 0.0f, 1.0f};
+        wren::Float32Array buffer(points.data(), points.size());
+
+        main.func("batch(_,_)")(wren::Mat4::translation(wren::Vec3(10, 20, 30)), &buffer);
+        REQUIRE(points == std::vector<float>{11.0f, 22.0f, 33.0f, 9.0f, 20.0f, 31.0f});
+
+        wren::Float32Array bad(std::vector<float>{1.0f, 2.0f});
+        REQUIRE_THROWS_WITH(main.func("batch(_,_)")(wren::Mat4(), &bad), Catch::Contains("not a multiple of 3"));
+    }
+}
@@ -0,0 +1,298 @@
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <wrenbind17/prefetch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+// Generated from tests/scripts by wrenbind17_embed_scripts()
+#include "testScripts.hpp"
+
+namespace wren = wrenbind17;
+
+class LazyBody {
+public:
+    LazyBody(double mass) : mass(mass) {
+    }
+
+    double mass;
+};
+
+TEST_CASE("Lazy modules") {
+    const std::string code = R"(
+        import "physics" for Body
+
+        class Main {
+            static mass() {
+                return Body.new(2.5).mass
+            }
+        }
+    )";
+
+    wren::VM vm;
+    size_t physicsCreated = 0;
+    size_t audioCreated = 0;
+
+    vm.lazyModule("physics", [&](wren::ForeignModule& m) {
+        physicsCreated++;
+        auto& cls = m.klass<LazyBody>("Body");
+        cls.ctor<double>();
+        cls.varReadonly<&LazyBody::mass>("mass");
+    });
+
+    vm.lazyModule("audio", [&](wren::ForeignModule& m) {
+        audioCreated++;
+        m.append("class Sound {}");
+    });
+
+    REQUIRE(physicsCreated == 0);
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+    REQUIRE(main.func("mass()")().as<double>() == Approx(2.5));
+
+    REQUIRE(physicsCreated == 1);
+    REQUIRE(audioCreated == 0);
+
+    SECTION("Accessed from C++") {
+        auto& audio = vm.module("audio");
+        REQUIRE(audioCreated == 1);
+        REQUIRE_THAT(audio.str(), Catch::Contains("class Sound {}"));
+        vm.module("audio");
+        REQUIRE(audioCreated == 1);
+    }
+
+    SECTION("Registered twice") {
+        REQUIRE_THROWS_AS(vm.lazyModule("physics", [](wren::ForeignModule& m) { (void)m; }), wren::Exception);
+
+        // The pending factory is kept
+        REQUIRE_THROWS_AS(vm.lazyModule("audio", [](wren::ForeignModule& m) { (void)m; }), wren::Exception);
+        REQUIRE_THAT(vm.module("audio").str(), Catch::Contains("class Sound {}"));
+        REQUIRE(audioCreated == 1);
+
+        vm.module("created");
+        REQUIRE_THROWS_AS(vm.lazyModule("created", [](wren::ForeignModule& m) { (void)m; }), wren::Exception);
+    }
+}
+
+TEST_CASE("Lazy module factory throws") {
+    const std::string code = R"(
+        import "broken" for Foo
+    )";
+
+    wren::VM vm;
+    vm.lazyModule("broken", [](wren::ForeignModule& m) {
+        (void)m;
+        throw wren::Exception("Failed to create module");
+    });
+
+    REQUIRE_THROWS_WITH(vm.runFromSource("main", code), Catch::Contains("Failed to create module"));
+
+    // Anything thrown by the factory must not escape through Wren
+    vm.lazyModule("other", [](wren::ForeignModule& m) {
+        (void)m;
+        throw 42;
+    });
+    REQUIRE_THROWS_WITH(vm.runFromSource("other_main", "import \"other\" for Foo"),
+                        Catch::Contains("Failed to create module other"));
+}
+
+TEST_CASE("Resolved imports are cached") {
+    const auto dir = std::filesystem::temp_directory_path() / "wrenbind17_resolve_cache";
+    std::filesystem::create_directories(dir);
+    const auto file = dir / "cachedlib.wren";
+    {
+        std::ofstream out(file);
+        out << "class A {}\nclass B {}\nclass C {}\n";
+    }
+
+    wren::VM vm({dir.string()});
+    size_t resolved = 0;
+    vm.setPathResolveFunc([&](const std::vector<std::string>& paths, const std::string& importer,
+                              const std::string& name) -> std::string {
+        resolved++;
+        return wren::detail::defaultPathResolveFn(paths, importer, name);
+    });
+
+    vm.runFromSource("main", "import \"cachedlib\" for A\nimport \"cachedlib\" for B\n");
+    REQUIRE(resolved == 1);
+
+    std::filesystem::remove(file);
+    REQUIRE_THROWS_AS(vm.runFromSource("main", "import \"cachedlib\" for C\n"), wren::CompileError);
+    REQUIRE(resolved == 2);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Large source files") {
+    const auto dir = std::filesystem::temp_directory_path() / "wrenbind17_large_source";
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream out(dir / "largelib.wren");
+        const std::string line = "// " + std::string(60, 'x') + "\n";
+        for (size_t i = 0; i < WRENBIND17_MMAP_THRESHOLD / line.size() + 1; i++) {
+            out << line;
+        }
+        out << "class Large {\n    static value { 42 }\n}\n";
+    }
+    {
+        std::ofstream out(dir / "largemain.wren");
+        out << "import \"largelib\" for Large\nclass Main {\n    static value() { Large.value }\n}\n";
+    }
+
+    wren::VM vm({dir.string()});
+    vm.runFromFile("main", (dir / "largelib.wren").string());
+    vm.runFromFile("other", (dir / "largemain.wren").string());
+    REQUIRE(vm.find("other", "Main").func("value()")().as<int>() == 42);
+    REQUIRE_THROWS_AS(vm.runFromFile("missing", (dir / "missing.wren").string()), wren::Exception);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Script archives") {
+    std::ostringstream os;
+    wren::Archive::write(os, {
+                                 {"main", "import \"utils/strings\" for Strings\nclass Main {\n"
+                                          "    static greet() { Strings.hello }\n}\n"},
+                                 {"utils/strings", "class Strings {\n    static hello { \"Hello\" }\n}\n"},
+                                 {"audio", "class Sound {}\n"},
+                             });
+    const auto blob = os.str();
+
+    SECTION("From memory") {
+        wren::Archive archive(reinterpret_cast<const uint8_t*>(blob.data()), blob.size());
+        REQUIRE(archive.size() == 3);
+        REQUIRE(archive.getName(0) == "audio");
+        REQUIRE(archive.getName(2) == "utils/strings");
+        REQUIRE(archive.contains("main"));
+        REQUIRE(!archive.contains("utils"));
+
+        size_t length = 0;
+        const auto source = archive.find("audio", length);
+        REQUIRE(source != nullptr);
+        REQUIRE(std::string(source) == "class Sound {}\n");
+        REQUIRE(length == 15);
+        REQUIRE(archive.find("missing", length) == nullptr);
+
+        wren::VM vm;
+        archive.install(vm);
+        vm.runFromModule("main");
+        REQUIRE(vm.find("main", "Main").func("greet()")().as<std::string>() == "Hello");
+        REQUIRE_THROWS_AS(vm.runFromSource("other", "import \"missing\" for Foo\n"), wren::CompileError);
+    }
+
+    SECTION("Sources are not copied") {
+        const wren::ArchiveView view(reinterpret_cast<const uint8_t*>(blob.data()), blob.size());
+        std::vector<std::string> loaded;
+
+        wren::VM vm(std::vector<std::string>{});
+        vm.setLoadSourceFunc([&](const std::string& name) -> const char* {
+            loaded.push_back(name);
+            size_t length = 0;
+            const auto source = view.find(name, length);
+            // Points into the archive memory
+            REQUIRE((source == nullptr || (source >= blob.data() && source < blob.data() + blob.size())));
+            return source;
+        });
+        vm.runFromModule("main");
+        REQUIRE(vm.find("main", "Main").func("greet()")().as<std::string>() == "Hello");
+        REQUIRE(loaded == std::vector<std::string>{"main", "utils/strings"});
+        REQUIRE_THROWS_AS(vm.runFromModule("missing"), wren::NotFound);
+    }
+
+    SECTION("From file") {
+        const auto path = std::filesystem::temp_directory_path() / "wrenbind17_archive.wbar";
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << blob;
+        }
+        {
+            wren::Archive archive(path.string());
+            REQUIRE(archive.size() == 3);
+            REQUIRE(archive.contains("utils/strings"));
+        }
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Invalid data") {
+        auto broken = blob;
+        broken[0] = 'X';
+        REQUIRE_THROWS_AS(wren::Archive(reinterpret_cast<const uint8_t*>(broken.data()), broken.size()),
+                          wren::Exception);
+        REQUIRE_THROWS_AS(wren::Archive(reinterpret_cast<const uint8_t*>(blob.data()), blob.size() - 1),
+                          wren::Exception);
+        std::ostringstream dup;
+        REQUIRE_THROWS_AS(wren::Archive::write(dup, {{"a", ""}, {"a", ""}}), wren::Exception);
+    }
+}
+
+TEST_CASE("Embedded scripts") {
+    const auto& archive = testScripts();
+    REQUIRE(archive.size() == 2);
+    REQUIRE(archive.contains("main"));
+    REQUIRE(archive.contains("utils/strings"));
+
+    wren::VM vm;
+    archive.install(vm);
+    vm.runFromModule("main");
+    REQUIRE(vm.find("main", "Main").func("greet()")().as<std::string>() == "Hello from embedded scripts");
+}
+
+TEST_CASE("Prefetch imports") {
+    const auto imports = wren::detail::scanImports(R"wren(
+        import "a" for A
+        // import "commented"
+        /* import "block /* nested */ comment" */
+        var str = "import \"quoted\" %("(" + ")") import"
+        import
+            "b"
+        var reimport = 1
+    )wren");
+    REQUIRE(imports == std::vector<std::string>{"a", "b"});
+
+    const auto dir = std::filesystem::temp_directory_path() / "wrenbind17_prefetch";
+    std::filesystem::create_directories(dir);
+    const auto write = [&](const std::string& name, const std::string& source) {
+        std::ofstream out(dir / (name + ".wren"));
+        out << source;
+    };
+    write("prefetchmain", "import \"prefetcha\" for A\nimport \"prefetchb\" for B\nimport \"test\" for Foo\n"
+                          "class Main {\n    static value() { A.value + B.value }\n}\n");
+    write("prefetcha", "import \"prefetchc\" for C\nclass A {\n    static value { C.value + 1 }\n}\n");
+    write("prefetchb", "import \"prefetchc\" for C\nclass B {\n    static value { C.value + 2 }\n}\n");
+    write("prefetchc", "class C {\n    static value { 10 }\n}\n");
+
+    wren::VM vm({dir.string()});
+    vm.module("test").append("class Foo {}\n");
+    std::atomic<size_t> loads{0};
+    vm.setLoadFileFunc([&](const std::string& path) -> std::string {
+        loads++;
+        return wren::detail::defaultLoadFileFn(path);
+    });
+
+    SECTION("On multiple threads") {
+        // The diamond prefetchc is read only once
+        REQUIRE(vm.prefetch("prefetchmain", wren::threadExecutor(2)) == 4);
+        REQUIRE(loads == 4);
+
+        vm.runFromModule("prefetchmain");
+        REQUIRE(loads == 4);
+        REQUIRE(vm.find(dir.string() + "/prefetchmain.wren", "Main").func("value()")().as<int>() == 23);
+    }
+
+    SECTION("Without an executor") {
+        REQUIRE(vm.prefetch("prefetchmain") == 4);
+        REQUIRE(loads == 4);
+
+        vm.runFromModule("prefetchmain");
+        REQUIRE(loads == 4);
+#if WREN_VERSION_NUMBER >= 4000 // >= 0.4.0
+        // Already imported modules are not read again
+        REQUIRE(vm.prefetch("prefetchmain") == 0);
+        REQUIRE(loads == 4);
+#endif
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+class PooledBullet {
+public:
+    PooledBullet(double speed) : speed(speed) {
+    }
+
+    double speed;
+};
+
+static size_t bulletAllocations = 0;
+
+template <typename T> class CountingAllocator : public wren::PoolAllocator<T> {
+public:
+    template <typename U> struct rebind {
+        typedef CountingAllocator<U> other;
+    };
+
+    CountingAllocator() noexcept = default;
+
+    template <typename U> CountingAllocator(const CountingAllocator<U>& other) noexcept {
+        (void)other;
+    }
+
+    T* allocate(const size_t n) {
+        bulletAllocations++;
+        return wren::PoolAllocator<T>::allocate(n);
+    }
+};
+
+template <> struct wrenbind17::ForeignAllocatorPolicy<PooledBullet> {
+    typedef CountingAllocator<PooledBullet> type;
+};
+
+TEST_CASE("Pool allocator reuses freed blocks") {
+    wren::PoolAllocator<PooledBullet> allocator;
+
+    const void* first = nullptr;
+    {
+        auto a = std::allocate_shared<PooledBullet>(allocator, 1.0);
+        first = a.get();
+    }
+
+    auto b = std::allocate_shared<PooledBullet>(allocator, 2.0);
+    REQUIRE(b.get() == first);
+    REQUIRE(b->speed == Approx(2.0));
+}
+
+TEST_CASE("Foreign objects use the allocator policy") {
+    const std::string code = R"(
+        import "test" for Bullet
+
+        class Main {
+            static spawn(n) {
+                var total = 0
+                for (i in 0...n) {
+                    total = total + Bullet.new(i).speed
+                }
+                return total
+            }
+
+            static pass(bullet) {
+                return bullet.speed
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<PooledBullet>("Bullet");
+    cls.ctor<double>();
+    cls.varReadonly<&PooledBullet::speed>("speed");
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    bulletAllocations = 0;
+    REQUIRE(main.func("spawn(_)")(10).as<int>() == 45);
+    REQUIRE(bulletAllocations == 10);
+
+    REQUIRE(main.func("pass(_)")(PooledBullet(4.0)).as<double>() == Approx(4.0));
+    REQUIRE(bulletAllocations == 11);
+
+    vm.gc();
+}
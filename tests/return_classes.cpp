@@ -136,7 +136,9 @@ TEST_CASE("Return class from C++ to Wren by reference") {
     auto main = vm.find("main", "Main").func("main()");
     auto res = main();
     REQUIRE(res.is<NonMoveableFoo>());
-    REQUIRE(res.shared<NonMoveableFoo>()->getMsg() == "Hello World");
+    REQUIRE(res.as<NonMoveableFoo*>()->getMsg() == "Hello World");
+    REQUIRE(res.as<const NonMoveableFoo&>().getMsg() == "Hello World");
+    REQUIRE_THROWS_AS(res.shared<NonMoveableFoo>(), wren::BadCast);
 }
 
 TEST_CASE("Return class from C++ to Wren by const reference") {
@@ -169,7 +171,9 @@ TEST_CASE("Return class from C++ to Wren by const reference") {
     auto main = vm.find("main", "Main").func("main()");
     auto res = main();
     REQUIRE(res.is<NonMoveableFoo>());
-    REQUIRE(res.shared<NonMoveableFoo>()->getMsg() == "Hello World");
+    REQUIRE(res.as<NonMoveableFoo*>()->getMsg() == "Hello World");
+    REQUIRE(res.as<const NonMoveableFoo&>().getMsg() == "Hello World");
+    REQUIRE_THROWS_AS(res.shared<NonMoveableFoo>(), wren::BadCast);
 }
 
 TEST_CASE("Return class from C++ to Wren by pointer") {
@@ -202,7 +206,9 @@ TEST_CASE("Return class from C++ to Wren by pointer") {
     auto main = vm.find("main", "Main").func("main()");
     auto res = main();
     REQUIRE(res.is<NonMoveableFoo>());
-    REQUIRE(res.shared<NonMoveableFoo>()->getMsg() == "Hello World");
+    REQUIRE(res.as<NonMoveableFoo*>()->getMsg() == "Hello World");
+    REQUIRE(res.as<const NonMoveableFoo&>().getMsg() == "Hello World");
+    REQUIRE_THROWS_AS(res.shared<NonMoveableFoo>(), wren::BadCast);
 }
 
 TEST_CASE("Return class from C++ to Wren by const pointer") {
@@ -235,6 +241,8 @@ TEST_CASE("Return class from C++ to Wren by const pointer") {
     auto main = vm.find("main", "Main").func("main()");
     auto res = main();
     REQUIRE(res.is<NonMoveableFoo>());
-    REQUIRE(res.shared<NonMoveableFoo>()->getMsg() == "Hello World");
+    REQUIRE(res.as<NonMoveableFoo*>()->getMsg() == "Hello World");
+    REQUIRE(res.as<const NonMoveableFoo&>().getMsg() == "Hello World");
+    REQUIRE_THROWS_AS(res.shared<NonMoveableFoo>(), wren::BadCast);
 }
 
@@ -246,9 +246,10 @@ TEST_CASE("shared_ptr set via property but pass as raw ptr to main") {
         auto main = vm.find("main", "Main").func("main(_)");
 
         REQUIRE(counter == 1);
-        auto r = main(parent.get());
-        REQUIRE(counter == 2);
+        // Raw pointers are borrowed and can not be stored as shared_ptr
+        REQUIRE_THROWS_WITH(main(parent.get()), Catch::Contains("borrowed"));
 
+        auto r = main(parent);
         REQUIRE(r.is<SomeClass*>());
         auto ptr = r.shared<SomeClass>();
         REQUIRE(ptr->getName() == "Hello Child");
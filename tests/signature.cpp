@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+class SignatureFoo {
+public:
+    SignatureFoo(int a, int b) {
+        (void)a;
+        (void)b;
+    }
+
+    void manyArgs(int a, int b, int c, int d, int e, int f, int g, int h, int i, int j, int k) {
+        (void)a, (void)b, (void)c, (void)d, (void)e, (void)f, (void)g, (void)h, (void)i, (void)j, (void)k;
+    }
+
+    int get() const {
+        return 0;
+    }
+
+    static void empty() {
+    }
+
+    SignatureFoo operator+(int other) const {
+        (void)other;
+        return *this;
+    }
+};
+
+static_assert(std::string_view(wren::detail::SignatureText<0>::names.data()) == "()");
+static_assert(std::string_view(wren::detail::SignatureText<3>::names.data()) == "(_,_,_)");
+static_assert(std::string_view(wren::detail::SignatureText<2>::params.data()) == "(arg0, arg1)");
+
+TEST_CASE("Generated Wren code") {
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<SignatureFoo>("Foo");
+    cls.ctor<int, int>();
+    cls.func<&SignatureFoo::manyArgs>("manyArgs");
+    cls.func<&SignatureFoo::get>("get");
+    cls.func<&SignatureFoo::operator+>(wren::ForeignMethodOperator::OPERATOR_ADD);
+    cls.funcStatic<&SignatureFoo::empty>("empty");
+
+    const auto code = m.str();
+    REQUIRE_THAT(code, Catch::Contains("foreign class Foo {\n"));
+    REQUIRE_THAT(code, Catch::Contains("    construct new (arg0, arg1) {}\n"));
+    REQUIRE_THAT(code, Catch::Contains("    foreign manyArgs(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, "
+                                       "arg9, arg10)\n"));
+    REQUIRE_THAT(code, Catch::Contains("    foreign get()\n"));
+    REQUIRE_THAT(code, Catch::Contains("    foreign +(rhs)\n"));
+    REQUIRE_THAT(code, Catch::Contains("    foreign static empty()\n"));
+
+    REQUIRE(cls.findFunc("manyArgs(_,_,_,_,_,_,_,_,_,_,_)", false).getName() == "manyArgs(_,_,_,_,_,_,_,_,_,_,_)");
+    REQUIRE(cls.findFunc("+(_)", false).getName() == "+(_)");
+    REQUIRE(cls.findFunc("empty()", true).getName() == "empty()");
+}
+
+TEST_CASE("Missing foreign method") {
+    wren::VM vm;
+    auto& m = vm.module("test");
+    auto& cls = m.klass<SignatureFoo>("Foo");
+    cls.ctor<int, int>();
+    cls.func<&SignatureFoo::get>("get");
+    m.append("class Util {\n    foreign static missing(a)\n}\n");
+
+    const std::string code = R"(
+        import "test" for Foo, Util
+    )";
+
+    REQUIRE_THROWS_WITH(vm.runFromSource("main", code), Catch::Contains("Util.missing(_) not found"));
+
+    REQUIRE(cls.lookupSignature("get()", false) != nullptr);
+    REQUIRE(cls.lookupSignature("get()", true) == nullptr);
+    REQUIRE(cls.lookupSignature("missing(_)", false) == nullptr);
+    REQUIRE_THROWS_AS(cls.findSignature("missing(_)", false), wren::NotFound);
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+#include <wrenbind17/wrenbind17.hpp>
+
+namespace wren = wrenbind17;
+
+class TrustedBody {
+public:
+    void applyForce(float x, float y, float z, float px, float py, float pz, float dt, float scale) noexcept {
+        fx += x * dt * scale;
+        fy += y * dt * scale;
+        fz += z * dt * scale;
+        torque += (px + py + pz) * dt;
+    }
+
+    double mass(double density) const {
+        return density * 2.0;
+    }
+
+    static std::string describe(const std::string& name, int id) {
+        return name + "#" + std::to_string(id);
+    }
+
+    float fx = 0.0f;
+    float fy = 0.0f;
+    float fz = 0.0f;
+    float torque = 0.0f;
+};
+
+class TrustedShape {
+public:
+    int area(int w, int h) const {
+        return w * h;
+    }
+
+    int perimeter(int w, int h) const {
+        return 2 * (w + h);
+    }
+};
+
+template <> struct wrenbind17::ForeignUncheckedPolicy<TrustedShape> : std::true_type {};
+
+TEST_CASE("Unchecked arguments") {
+    const std::string code = R"(
+        import "test" for Body, Shape
+
+        class Main {
+            static step(body, n) {
+                for (i in 0...n) {
+                    body.applyForce(1, 2, 3, 0.5, 0.5, 1, 0.5, 2)
+                }
+            }
+
+            static mass(body) {
+                return body.mass(1.5)
+            }
+
+            static describe() {
+                return Body.describe("body", 7)
+            }
+
+            static shape(shape) {
+                return shape.area(3, 4) + shape.perimeter(3, 4)
+            }
+
+            static wrongShape(shape) {
+                return shape.perimeter("3", 4)
+            }
+        }
+    )";
+
+    wren::VM vm;
+    auto& m = vm.module("test");
+    {
+        auto& cls = m.klass<TrustedBody>("Body");
+        cls.ctor<>();
+        cls.func<&TrustedBody::applyForce, wren::unchecked>("applyForce");
+        cls.func<&TrustedBody::mass, wren::unchecked>("mass");
+        cls.funcStatic<&TrustedBody::describe, wren::unchecked>("describe");
+    }
+    {
+        auto& cls = m.klass<TrustedShape>("Shape");
+        cls.ctor<>();
+        cls.func<&TrustedShape::area>("area");
+        cls.func<&TrustedShape::perimeter, wren::checked>("perimeter");
+    }
+
+    vm.runFromSource("main", code);
+    auto main = vm.find("main", "Main");
+
+    SECTION("Member functions") {
+        auto body = std::make_shared<TrustedBody>();
+        main.func("step(_,_)")(body, 10);
+        REQUIRE(body->fx == Approx(10.0f));
+        REQUIRE(body->fy == Approx(20.0f));
+        REQUIRE(body->fz == Approx(30.0f));
+        REQUIRE(body->torque == Approx(10.0f));
+
+        REQUIRE(main.func("mass(_)")(body).as<double>() == Approx(3.0));
+    }
+
+    SECTION("Static functions") {
+        REQUIRE(main.func("describe()")().as<std::string>() == "body#7");
+    }
+
+    SECTION("Class policy") {
+        REQUIRE(main.func("shape(_)")(TrustedShape()).as<int>() == 26);
+        REQUIRE_THROWS_WITH(main.func("wrongShape(_)")(TrustedShape()), Catch::Contains("expected number"));
+    }
+}
@@ -0,0 +1,89 @@
+// Packs all .wren files of a directory into a single archive, see wrenbind17::Archive
+//
+// Only the archive format is used here, so the tool does not need Wren.
+//
+// Usage: wrenbind17_pack [--embed <name>] <directory> <output>
+//
+// The module names are the file paths relative to the directory, with forward
+// slashes and without the ".wren" extension, for example "utils/strings".
+//
+// With --embed the output is a C++ source file holding the archive as a constant
+// byte array, and defining "const wrenbind17::Archive& <name>()" to access it.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <wrenbind17/archiveview.hpp>
+
+namespace wren = wrenbind17;
+namespace fs = std::filesystem;
+
+static std::vector<std::pair<std::string, std::string>> collect(const fs::path& root) {
+    std::vector<std::pair<std::string, std::string>> modules;
+
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".wren")
+            continue;
+
+        auto name = fs::relative(entry.path(), root).replace_extension().generic_string();
+        std::ifstream file(entry.path(), std::ios::binary);
+        if (!file)
+            throw wren::Exception("Failed to open " + entry.path().string());
+        std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        modules.emplace_back(std::move(name), std::move(source));
+    }
+
+    return modules;
+}
+
+static void embed(std::ostream& out, const std::string& name, const std::string& blob) {
+    static const char* hex = "0123456789abcdef";
+
+    out << "// Generated by wrenbind17_pack, do not edit\n";
+    out << "#include <wrenbind17/archive.hpp>\n\n";
+    out << "namespace {\n";
+    out << "    alignas(8) const uint8_t data[] = {";
+    for (size_t i = 0; i < blob.size(); i++) {
+        const auto c = static_cast<uint8_t>(blob[i]);
+        out << (i % 16 == 0 ? "\n        " : " ") << "0x" << hex[c >> 4] << hex[c & 0xf] << ",";
+    }
+    out << "\n    };\n";
+    out << "} // namespace\n\n";
+    out << "const wrenbind17::Archive& " << name << "() {\n";
+    out << "    static const wrenbind17::Archive archive(data, sizeof(data));\n";
+    out << "    return archive;\n";
+    out << "}\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string embedName;
+    int arg = 1;
+    if (argc == 5 && std::string(argv[1]) == "--embed") {
+        embedName = argv[2];
+        arg = 3;
+    } else if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " [--embed <name>] <directory> <output>" << std::endl;
+        return 1;
+    }
+
+    try {
+        std::ostringstream blob;
+        wren::ArchiveView::write(blob, collect(argv[arg]));
+
+        std::ofstream out(argv[arg + 1], std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw wren::Exception(std::string("Failed to create ") + argv[arg + 1]);
+        if (embedName.empty())
+            out << blob.str();
+        else
+            embed(out, embedName, blob.str());
+        if (!out)
+            throw wren::Exception(std::string("Failed to write ") + argv[arg + 1]);
+    } catch (std::exception& e) {
+        std::cerr << "wrenbind17_pack: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}